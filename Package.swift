@@ -56,6 +56,11 @@ let package = Package(
 			dependencies: [.target(name: "Pulsar")],
 			swiftSettings: [.interoperabilityMode(.Cxx)],
 
+		),
+		.executableTarget(
+			name: "PulsarBenchmarks",
+			dependencies: [.target(name: "Pulsar")],
+			swiftSettings: [.interoperabilityMode(.Cxx)]
 		)
 	]
 )
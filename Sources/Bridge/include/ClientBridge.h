@@ -0,0 +1,13 @@
+// ClientBridge.h
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Closes the client without blocking. If ctx is null the result is discarded.
+void pulsar_client_close_async(void *client, void *ctx);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -7,6 +7,9 @@ extern "C" {
 
 void pulsar_consumer_acknowledge_async(void *consumer, const void *message,
                                        void *ctx);
+// Closes the consumer without blocking, flushing pending acknowledgements.
+// If ctx is null the result is discarded.
+void pulsar_consumer_close_async(void *consumer, void *ctx);
 #ifdef __cplusplus
 } // extern "C"
 #endif
\ No newline at end of file
@@ -1,9 +1,43 @@
 // MessageBridge.h
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 
-// Get message data as a newly allocated buffer that Swift owns
-// Returns the size of the data, and fills outData with a malloc'd pointer
-// Caller is responsible for freeing the returned pointer
-size_t getDataFromMessage(const void *message, void **outData);
+// Borrows the message payload without copying it. Returns a handle that keeps
+// a copy of the message, and with it the payload, alive until it is passed to
+// Bridge_Msg_releasePayload.
+void *Bridge_Msg_retainPayload(const void *message, const void **outData,
+                               size_t *outSize);
+void Bridge_Msg_releasePayload(void *handle);
+
+// The string accessors below return borrowed pointers into the message's
+// shared implementation. They stay valid as long as any copy of the message
+// is alive and are NOT null-terminated; use outSize for the length.
+
+bool Bridge_Msg_hasPartitionKey(const void *message);
+const char *Bridge_Msg_getPartitionKey(const void *message, size_t *outSize);
+
+bool Bridge_Msg_hasOrderingKey(const void *message);
+const char *Bridge_Msg_getOrderingKey(const void *message, size_t *outSize);
+
+const char *Bridge_Msg_getTopicName(const void *message, size_t *outSize);
+
+// Returns nullptr if the property is not set.
+const char *Bridge_Msg_getProperty(const void *message, const char *name,
+                                   size_t *outSize);
+
+typedef void (*Bridge_Msg_PropertyVisitor)(void *ctx, const char *name,
+                                           size_t nameSize, const char *value,
+                                           size_t valueSize);
+
+void Bridge_Msg_forEachProperty(const void *message,
+                                Bridge_Msg_PropertyVisitor visitor, void *ctx);
+
+unsigned long long Bridge_Msg_getPublishTimestamp(const void *message);
+unsigned long long Bridge_Msg_getEventTimestamp(const void *message);
+int Bridge_Msg_getRedeliveryCount(const void *message);
+
+void Bridge_Msg_getMessageId(const void *message, long long *ledgerId,
+                             long long *entryId, int *partition,
+                             int *batchIndex);
@@ -8,6 +8,13 @@ void Bridge_MB_setContent(pulsar::MessageBuilder *b, const void *data,
 void Bridge_MB_setProperty(pulsar::MessageBuilder *b, const char *name,
                            const char *value);
 
+void Bridge_MB_setPartitionKey(pulsar::MessageBuilder *b, const char *key);
+void Bridge_MB_setPartitionKeyBytes(pulsar::MessageBuilder *b,
+                                    const void *data, size_t size);
+void Bridge_MB_setOrderingKey(pulsar::MessageBuilder *b, const char *key);
+void Bridge_MB_setEventTimestamp(pulsar::MessageBuilder *b,
+                                 unsigned long long ts);
+
 void Bridge_MB_setAllocatedContent(pulsar::MessageBuilder *b, void *data,
                                    size_t size);
 
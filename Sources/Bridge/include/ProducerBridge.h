@@ -6,6 +6,13 @@ extern "C" {
 #endif
 
 void pulsar_producer_send_async(void *producer, const void *message, void *ctx);
+void pulsar_producer_flush_async(void *producer, void *ctx);
+// Closes the producer without blocking. If ctx is null the result is
+// discarded.
+void pulsar_producer_close_async(void *producer, void *ctx);
+// Flushes pending messages, then closes the producer, without blocking and
+// without reporting the result.
+void pulsar_producer_flush_and_close_async(void *producer);
 
 #ifdef __cplusplus
 } // extern "C"
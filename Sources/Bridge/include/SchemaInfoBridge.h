@@ -0,0 +1,15 @@
+// SchemaInfoBridge.h
+#pragma once
+#include <pulsar/Schema.h>
+
+// Builds a KEY_VALUE schema from a key and value schema, using the same binary
+// layout and properties as the other Pulsar clients.
+pulsar::SchemaInfo
+Bridge_SI_createKeyValue(const pulsar::SchemaInfo *keySchema,
+                         const pulsar::SchemaInfo *valueSchema,
+                         int encodingType);
+
+// Adds a property to a schema property map before it is passed to a
+// SchemaInfo.
+void Bridge_SI_setProperty(pulsar::StringMap *properties, const char *name,
+                           const char *value);
@@ -0,0 +1,18 @@
+#include "ClientBridge.h"
+#include <pulsar/Client.h>
+
+extern "C" void pulsar_swift_result_callback(void *ctx, int result);
+
+extern "C" void pulsar_client_close_async(void *client, void *ctx) {
+  if (!client) {
+    return;
+  }
+
+  auto cl = static_cast<pulsar::Client *>(client);
+
+  cl->closeAsync([ctx](pulsar::Result res) {
+    if (ctx) {
+      pulsar_swift_result_callback(ctx, static_cast<int>(res));
+    }
+  });
+}
@@ -15,4 +15,18 @@ extern "C" void pulsar_consumer_acknowledge_async(void *producer,
   cons->acknowledgeAsync(*msg, [ctx](pulsar::Result res) {
     pulsar_swift_result_callback(ctx, static_cast<int>(res));
   });
-}
\ No newline at end of file
+}
+
+extern "C" void pulsar_consumer_close_async(void *consumer, void *ctx) {
+  if (!consumer) {
+    return;
+  }
+
+  auto cons = static_cast<pulsar::Consumer *>(consumer);
+
+  cons->closeAsync([ctx](pulsar::Result res) {
+    if (ctx) {
+      pulsar_swift_result_callback(ctx, static_cast<int>(res));
+    }
+  });
+}
@@ -12,6 +12,25 @@ void Bridge_MB_setProperty(pulsar::MessageBuilder *b, const char *name,
                  value ? std::string{value} : std::string{});
 }
 
+void Bridge_MB_setPartitionKey(pulsar::MessageBuilder *b, const char *key) {
+  b->setPartitionKey(key ? std::string{key} : std::string{});
+}
+
+void Bridge_MB_setPartitionKeyBytes(pulsar::MessageBuilder *b,
+                                    const void *data, size_t size) {
+  b->setPartitionKey(data ? std::string(static_cast<const char *>(data), size)
+                          : std::string{});
+}
+
+void Bridge_MB_setOrderingKey(pulsar::MessageBuilder *b, const char *key) {
+  b->setOrderingKey(key ? std::string{key} : std::string{});
+}
+
+void Bridge_MB_setEventTimestamp(pulsar::MessageBuilder *b,
+                                 unsigned long long ts) {
+  b->setEventTimestamp(ts);
+}
+
 void Bridge_MB_setAllocatedContent(pulsar::MessageBuilder *b, void *data,
                                    size_t size) {
   b->setAllocatedContent(data, size);
@@ -2,29 +2,98 @@
 #include <cstdlib>
 #include <cstring>
 #include <pulsar/Message.h>
+#include <string>
 
-size_t getDataFromMessage(const void *message, void **outData) {
-  if (!message || !outData) {
-    *outData = nullptr;
-    return 0;
-  }
+void *Bridge_Msg_retainPayload(const void *message, const void **outData,
+                               size_t *outSize) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  auto retained = new pulsar::Message(*msg);
+  *outData = retained->getData();
+  *outSize = retained->getLength();
+  return retained;
+}
+
+void Bridge_Msg_releasePayload(void *handle) {
+  delete static_cast<pulsar::Message *>(handle);
+}
+
+static const char *borrow(const std::string &value, size_t *outSize) {
+  if (outSize)
+    *outSize = value.size();
+  return value.data();
+}
+
+bool Bridge_Msg_hasPartitionKey(const void *message) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  return msg->hasPartitionKey();
+}
 
+const char *Bridge_Msg_getPartitionKey(const void *message, size_t *outSize) {
   auto msg = static_cast<const pulsar::Message *>(message);
-  const void *data = msg->getData();
-  size_t size = msg->getLength();
+  return borrow(msg->getPartitionKey(), outSize);
+}
+
+bool Bridge_Msg_hasOrderingKey(const void *message) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  return msg->hasOrderingKey();
+}
 
-  if (size == 0) {
-    *outData = nullptr;
-    return 0;
+const char *Bridge_Msg_getOrderingKey(const void *message, size_t *outSize) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  return borrow(msg->getOrderingKey(), outSize);
+}
+
+const char *Bridge_Msg_getTopicName(const void *message, size_t *outSize) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  return borrow(msg->getTopicName(), outSize);
+}
+
+const char *Bridge_Msg_getProperty(const void *message, const char *name,
+                                   size_t *outSize) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  std::string key = name ? std::string{name} : std::string{};
+  if (!msg->hasProperty(key)) {
+    if (outSize)
+      *outSize = 0;
+    return nullptr;
   }
+  return borrow(msg->getProperty(key), outSize);
+}
 
-  void *buffer = malloc(size);
-  if (!buffer) {
-    *outData = nullptr;
-    return 0;
+void Bridge_Msg_forEachProperty(const void *message,
+                                Bridge_Msg_PropertyVisitor visitor, void *ctx) {
+  if (!message || !visitor) {
+    return;
   }
+  auto msg = static_cast<const pulsar::Message *>(message);
+  for (const auto &entry : msg->getProperties()) {
+    visitor(ctx, entry.first.data(), entry.first.size(), entry.second.data(),
+            entry.second.size());
+  }
+}
 
-  memcpy(buffer, data, size);
-  *outData = buffer;
-  return size;
+unsigned long long Bridge_Msg_getPublishTimestamp(const void *message) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  return msg->getPublishTimestamp();
+}
+
+unsigned long long Bridge_Msg_getEventTimestamp(const void *message) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  return msg->getEventTimestamp();
+}
+
+int Bridge_Msg_getRedeliveryCount(const void *message) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  return msg->getRedeliveryCount();
+}
+
+void Bridge_Msg_getMessageId(const void *message, long long *ledgerId,
+                             long long *entryId, int *partition,
+                             int *batchIndex) {
+  auto msg = static_cast<const pulsar::Message *>(message);
+  const pulsar::MessageId &id = msg->getMessageId();
+  *ledgerId = id.ledgerId();
+  *entryId = id.entryId();
+  *partition = id.partition();
+  *batchIndex = id.batchIndex();
 }
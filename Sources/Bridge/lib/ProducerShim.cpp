@@ -3,6 +3,7 @@
 
 extern "C" void pulsar_swift_send_callback(void *ctx, int result,
                                            const void *messageId);
+extern "C" void pulsar_swift_result_callback(void *ctx, int result);
 
 extern "C" void pulsar_producer_send_async(void *producer, const void *message,
                                            void *ctx) {
@@ -19,3 +20,43 @@ extern "C" void pulsar_producer_send_async(void *producer, const void *message,
                                    static_cast<const void *>(&msgId));
       });
 }
+
+extern "C" void pulsar_producer_flush_async(void *producer, void *ctx) {
+  if (!producer) {
+    return;
+  }
+
+  auto prod = static_cast<pulsar::Producer *>(producer);
+
+  prod->flushAsync([ctx](pulsar::Result res) {
+    pulsar_swift_result_callback(ctx, static_cast<int>(res));
+  });
+}
+
+extern "C" void pulsar_producer_close_async(void *producer, void *ctx) {
+  if (!producer) {
+    return;
+  }
+
+  auto prod = static_cast<pulsar::Producer *>(producer);
+
+  prod->closeAsync([ctx](pulsar::Result res) {
+    if (ctx) {
+      pulsar_swift_result_callback(ctx, static_cast<int>(res));
+    }
+  });
+}
+
+extern "C" void pulsar_producer_flush_and_close_async(void *producer) {
+  if (!producer) {
+    return;
+  }
+
+  // The copy shares the producer implementation and keeps it alive until
+  // the close has been issued.
+  pulsar::Producer prod = *static_cast<pulsar::Producer *>(producer);
+
+  prod.flushAsync([prod](pulsar::Result) mutable {
+    prod.closeAsync([](pulsar::Result) {});
+  });
+}
@@ -0,0 +1,16 @@
+// SchemaInfoShims.cpp
+#include "SchemaInfoBridge.h"
+
+pulsar::SchemaInfo
+Bridge_SI_createKeyValue(const pulsar::SchemaInfo *keySchema,
+                         const pulsar::SchemaInfo *valueSchema,
+                         int encodingType) {
+  return pulsar::SchemaInfo(
+      *keySchema, *valueSchema,
+      static_cast<pulsar::KeyValueEncodingType>(encodingType));
+}
+
+void Bridge_SI_setProperty(pulsar::StringMap *properties, const char *name,
+                           const char *value) {
+  (*properties)[name] = value;
+}
@@ -19,11 +19,15 @@ public final class Client: Sendable {
 		var raw: _Pulsar.Client
 		init(_ raw: _Pulsar.Client) { self.raw = raw }
 		deinit {
-			raw.close()
+			// Never block the releasing thread, close in the background instead.
+			withUnsafeMutablePointer(to: &raw) { clientPtr in
+				pulsar_client_close_async(clientPtr, nil)
+			}
 		}
 	}
 
 	private let state: Mutex<Box>
+	private let owned: Mutex<[WeakShutdownReference]>
 
 	let producersCreated: Counter
 	let producersFailed: Counter
@@ -57,6 +61,7 @@ public final class Client: Sendable {
 			rawConfig
 		)
 		self.state = Mutex(Box(raw))
+		self.owned = Mutex([])
 		self.producersCreated = Counter(label: "pulsar_client_producers_created")
 		self.producersFailed = Counter(label: "pulsar_client_producers_failed")
 		self.consumersCreated = Counter(label: "pulsar_client_consumers_created")
@@ -92,7 +97,37 @@ public final class Client: Sendable {
 			throw e
 		}
 		producersCreated.increment()
-		return Producer(producer: producer, topic: topic)
+		let wrapper = Producer<T>(producer: producer, topic: topic)
+		register(wrapper)
+		return wrapper
+	}
+
+	/// Create a pool of producers sharding one topic.
+	/// - Parameters:
+	///   - topic: The topic to create the producers on.
+	///   - size: The number of producers in the pool.
+	///   - routing: How messages are distributed across the producers.
+	///   - configuration: The producer configuration (optional). If it has a name, each producer gets an index suffix.
+	/// - Returns: The producer pool.
+	///
+	/// Producers share connections unless ``ClientConfiguration/connectionsPerBroker`` is raised. Each producer then picks
+	/// one of the connections at random, so separate connections are not guaranteed.
+	public func producerPool<T: PulsarSchema>(
+		for topic: String,
+		size: Int = ProcessInfo.processInfo.activeProcessorCount,
+		routing: ProducerPoolRouting = .threadAffinity,
+		configuration: ProducerConfiguration = ProducerConfiguration()
+	) throws -> ProducerPool<T> {
+		guard size > 0, configuration.accessMode == .shared else {
+			throw PulsarError.invalidConfiguration
+		}
+		var producers: [Producer<T>] = []
+		producers.reserveCapacity(size)
+		for index in 0 ..< size {
+			let name = configuration.name.map { "\($0)-\(index)" }
+			producers.append(try producer(for: topic, configuration: configuration.renamed(name)))
+		}
+		return ProducerPool(producers: producers, topic: topic, routing: routing)
 	}
 
 	/// Subscribe to a topic.
@@ -128,11 +163,20 @@ public final class Client: Sendable {
 			throw e
 		}
 		consumersCreated.increment()
-		return Consumer(consumer: consumer, subscriptionName: subscription)
+		let wrapper = Consumer<T>(
+			consumer: consumer,
+			subscriptionName: subscription,
+			tracer: LatencyTracer(configuration: config.latencyTracing, topic: topic, subscription: subscription)
+		)
+		register(wrapper)
+		return wrapper
 	}
 
 	/// Close the client.
+	///
+	/// Ends the message streams of the client's listeners and blocks until the client is closed.
 	public func close() throws {
+		finishOwnedStreams()
 		let result = state.withLock { box in
 			box.raw.close()
 		}
@@ -141,13 +185,88 @@ public final class Client: Sendable {
 		}
 	}
 
+	/// Close the client asynchronously.
+	///
+	/// Closes all producers, consumers and listeners of the client without draining them, ending the listeners' message
+	/// streams. Use ``shutdown(deadline:)`` to deliver pending messages and acknowledgements first.
+	public func close() async throws {
+		finishOwnedStreams()
+		try await close(deadline: nil)
+	}
+
+	/// Gracefully shut the client down.
+	///
+	/// Shuts down all producers, consumers and listeners created by this client in parallel, flushing pending messages
+	/// and acknowledgements, then closes the client. If the deadline passes first, the method throws
+	/// ``PulsarError/timeout`` and the remaining work continues in the background.
+	/// - Parameter deadline: The latest time to wait for the shutdown to complete.
+	public func shutdown(deadline: ContinuousClock.Instant) async throws {
+		let resources = owned.withLock { references in
+			let alive = references.compactMap(\.object)
+			references.removeAll()
+			return alive
+		}
+		let drainError = await withTaskGroup(of: Error?.self) { group in
+			for resource in resources {
+				group.addTask {
+					do {
+						try await resource.shutdown(deadline: deadline)
+						return nil
+					} catch {
+						return error
+					}
+				}
+			}
+			var firstError: Error?
+			for await error in group where firstError == nil {
+				firstError = error
+			}
+			return firstError
+		}
+		try await close(deadline: deadline)
+		if let drainError {
+			throw drainError
+		}
+	}
+
+	private func close(deadline: ContinuousClock.Instant?) async throws {
+		try await awaitResult(deadline: deadline) { ctx in
+			state.withLock { box in
+				withUnsafeMutablePointer(to: &box.raw) { clientPtr in
+					pulsar_client_close_async(clientPtr, ctx)
+				}
+			}
+		}
+	}
+
+	// End the message streams of the client's listeners, so loops over them finish once the client is closed.
+	private func finishOwnedStreams() {
+		let resources = owned.withLock { references in
+			let alive = references.compactMap(\.object)
+			references.removeAll()
+			return alive
+		}
+		for resource in resources {
+			resource.finishStream()
+		}
+	}
+
+	private func register(_ resource: any GracefulShutdown) {
+		owned.withLock { references in
+			references.removeAll { $0.object == nil }
+			references.append(WeakShutdownReference(object: resource))
+		}
+	}
+
 	/// Open a listener on the topic.
 	/// - Parameters:
 	///   - topic: The topic to listen to.
 	///   - subscription: The subscription name.
 	/// - Returns: The Listener.
 	public func listener<T: PulsarSchema>(on topic: String, subscription: String) throws -> Listener<T> {
-		let listener = Listener<T>()
+		let listener = Listener<T>(
+			tracer: LatencyTracer(configuration: config.latencyTracing, topic: topic, subscription: subscription)
+		)
 		var configuration = _Pulsar.ConsumerConfiguration()
 		let listenerCtx = Unmanaged.passRetained(listener).toOpaque()
 		withUnsafeMutablePointer(to: &configuration) { cfgPtr in
@@ -182,7 +301,23 @@ public final class Client: Sendable {
 		let consumerWrapper = Consumer<T>(consumer: consumer, listenerContext: listenerCtx, subscriptionName: subscription)
 		listener.attach(consumer: consumerWrapper)
 		listenersCreated.increment()
+		register(listener)
 
 		return listener
 	}
 }
+
+/// Resources created by a ``Client`` that take part in its graceful shutdown.
+protocol GracefulShutdown: AnyObject, Sendable {
+	func shutdown(deadline: ContinuousClock.Instant) async throws
+	/// Ends the stream of messages handed to the application, called when the client closes without draining.
+	func finishStream()
+}
+
+extension GracefulShutdown {
+	func finishStream() {}
+}
+
+struct WeakShutdownReference: @unchecked Sendable {
+	weak var object: (any GracefulShutdown)?
+}
@@ -113,6 +113,8 @@ public final class ClientConfiguration: Sendable {
 	public let proxy: ProxyConfiguration?
 	/// Interval for keep-alive messages.
 	public let keepAliveInterval: Duration
+	/// End-to-end latency tracing for consumers and listeners, or nil to disable it.
+	public let latencyTracing: LatencyTracingConfiguration?
 
 	/// Creates a new client configuration.
 	public init(
@@ -130,7 +132,8 @@ public final class ClientConfiguration: Sendable {
 		partitionsUpdateInterval: Duration = .seconds(60),
 		connectTimeout: Duration = .milliseconds(10_000),
 		proxy: ProxyConfiguration? = nil,
-		keepAliveInterval: Duration = .seconds(30)
+		keepAliveInterval: Duration = .seconds(30),
+		latencyTracing: LatencyTracingConfiguration? = nil
 	) {
 		self.state = Mutex(Box(CxxPulsar.pulsar.ClientConfiguration()))
 		self.memoryLimit = memoryLimit
@@ -148,6 +151,7 @@ public final class ClientConfiguration: Sendable {
 		self.connectTimeout = connectTimeout
 		self.proxy = proxy
 		self.keepAliveInterval = keepAliveInterval
+		self.latencyTracing = latencyTracing
 		setCxxConfig()
 	}
 
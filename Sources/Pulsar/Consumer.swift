@@ -28,13 +28,20 @@ public final class Consumer<T: PulsarSchema>: Sendable {
 	let subscriptionName: String
 	let counterFailed: Counter
 	let counterSuccess: Counter
+	let tracer: LatencyTracer?
 	private let state: Mutex<Box>
 
-	init(consumer: _Pulsar.Consumer, listenerContext: UnsafeMutableRawPointer? = nil, subscriptionName: String) {
+	init(
+		consumer: _Pulsar.Consumer,
+		listenerContext: UnsafeMutableRawPointer? = nil,
+		subscriptionName: String,
+		tracer: LatencyTracer? = nil
+	) {
 		let box = Box(consumer)
 		box.listenerContext = listenerContext
 		self.state = Mutex(box)
 		self.subscriptionName = subscriptionName
+		self.tracer = tracer
 		self.counterAll = Counter(label: "pulsar_consumer_messages_sent_\(subscriptionName)")
 		self.counterFailed = Counter(label: "pulsar_consumer_messages_failed_\(subscriptionName)")
 		self.counterSuccess = Counter(label: "pulsar_consumer_messages_successful_\(subscriptionName)")
@@ -62,7 +69,7 @@ public final class Consumer<T: PulsarSchema>: Sendable {
 			throw PulsarError(cxx: result)
 		}
 		self.counterSuccess.increment()
-		return Message<T>(cppMessage)
+		return Message<T>(cppMessage, trace: tracer?.sample())
 	}
 
 	/// Close the consumer synchronously.
@@ -75,18 +82,53 @@ public final class Consumer<T: PulsarSchema>: Sendable {
 		}
 	}
 
+	/// Close the consumer asynchronously.
+	///
+	/// Pending acknowledgements are flushed to the broker before the consumer is closed.
+	public func close() async throws {
+		try await close(deadline: nil)
+	}
+
+	/// Gracefully shut the consumer down.
+	///
+	/// Flushes pending acknowledgements and closes the consumer. If the deadline passes first, the method throws
+	/// ``PulsarError/timeout`` and the consumer is still closed in the background.
+	/// - Parameter deadline: The latest time to wait for the shutdown to complete.
+	public func shutdown(deadline: ContinuousClock.Instant) async throws {
+		try await close(deadline: deadline)
+	}
+
+	private func close(deadline: ContinuousClock.Instant?) async throws {
+		// Keep the consumer, and with it the listener context, alive until the close completes: a listener may still
+		// be invoked while closing, even after the deadline has passed.
+		try await awaitResult(deadline: deadline, retaining: self) { ctx in
+			state.withLock { box in
+				withUnsafeMutablePointer(to: &box.raw) { consPtr in
+					pulsar_consumer_close_async(UnsafeMutableRawPointer(consPtr), ctx)
+				}
+			}
+		}
+	}
+
 	/// Acknowledge a message.
 	/// - Parameter message: The message to acknowledge.
 	public func acknowledge(_ message: Message<T>) throws {
+		let ackStart = message.trace?.beginAcknowledge()
 		let result = state.withLock { box in
 			box.raw.acknowledge(message.rawMessage)
 		}
 		if result.rawValue != 0 { //ResultOk
 			throw PulsarError(cxx: result)
 		}
+		if let ackStart {
+			message.trace?.endAcknowledge(startedAt: ackStart)
+		}
 	}
 
+	/// Acknowledge a message asynchronously.
+	/// - Parameter message: The message to acknowledge.
 	public func acknowledge(_ message: Message<T>) async throws {
+		let ackStart = message.trace?.beginAcknowledge()
 		try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
 			let boxObj = ContinuationBox(continuation)
 			let ctx = Unmanaged.passRetained(boxObj).toOpaque()
@@ -103,9 +145,14 @@ public final class Consumer<T: PulsarSchema>: Sendable {
 				}
 			}
 		}
+		if let ackStart {
+			message.trace?.endAcknowledge(startedAt: ackStart)
+		}
 	}
 }
 
+extension Consumer: GracefulShutdown {}
+
 @_cdecl("pulsar_swift_result_callback")
 func resultCallback(_ ctx: UnsafeMutableRawPointer?, _ result: Int32) {
 	let logger: Logger = Logger(label: "ResultCallback")
@@ -116,7 +163,7 @@ func resultCallback(_ ctx: UnsafeMutableRawPointer?, _ result: Int32) {
 
 	let any = Unmanaged<AnyObject>.fromOpaque(ctx).takeRetainedValue()
 
-	if let contBox = any as? ContinuationBox {
+	if let contBox = any as? ResultCallbackBox {
 		contBox.checkContinuation(result: result, context: "resultCallback")
 	}
 
@@ -1,5 +1,6 @@
 import Logging
 import Metrics
+import Synchronization
 
 final class ContinuationBox: Sendable {
 	let cont: CheckedContinuation<Void, Error>
@@ -35,3 +36,78 @@ final class ContinuationBox: Sendable {
 		}
 	}
 }
+
+/// A box handed to the C++ result callbacks as context.
+protocol ResultCallbackBox: AnyObject {
+	func checkContinuation(result: Int32, context: String)
+}
+
+extension ContinuationBox: ResultCallbackBox {}
+
+/// A continuation box that is resumed by whichever comes first, the C++ callback or the deadline.
+///
+/// If the deadline wins, the operation keeps running in the C++ client and its late result is dropped. The box stays
+/// retained by the C++ callback until then, so anything it retains outlives the operation.
+final class DeadlineContinuationBox: ResultCallbackBox, Sendable {
+	private let cont: Mutex<CheckedContinuation<Void, Error>?>
+	private let timer = Mutex<Task<Void, Never>?>(nil)
+	private let retained: (any AnyObject & Sendable)?
+	let logger = Logger(label: "DeadlineContinuationBox")
+
+	init(_ cont: CheckedContinuation<Void, Error>, retaining retained: (any AnyObject & Sendable)? = nil) {
+		self.cont = Mutex(cont)
+		self.retained = retained
+	}
+
+	func arm(deadline: ContinuousClock.Instant) {
+		let task = Task { [weak self] in
+			try? await Task.sleep(until: deadline, clock: .continuous)
+			guard !Task.isCancelled else { return }
+			self?.take()?.resume(throwing: PulsarError.timeout)
+		}
+		timer.withLock { $0 = task }
+	}
+
+	func checkContinuation(result: Int32, context: String = "Generic") {
+		timer.withLock { task in
+			task?.cancel()
+			task = nil
+		}
+		guard let cont = take() else {
+			logger.debug("\(context): Operation completed after its deadline")
+			return
+		}
+		if result == 0 {
+			cont.resume()
+		} else {
+			cont.resume(throwing: PulsarError(cxx: _Pulsar.Result(rawValue: Int8(result))))
+		}
+	}
+
+	private func take() -> CheckedContinuation<Void, Error>? {
+		cont.withLock { cont in
+			let taken = cont
+			cont = nil
+			return taken
+		}
+	}
+}
+
+/// Start an asynchronous C++ operation reporting through `pulsar_swift_result_callback` and wait for its result.
+/// - Parameters:
+///   - deadline: The latest time to wait, or `nil` to wait until the operation completes.
+///   - retained: An object kept alive until the operation completes, even if the deadline passes first.
+///   - start: Starts the operation with the retained callback context.
+func awaitResult(
+	deadline: ContinuousClock.Instant?,
+	retaining retained: (any AnyObject & Sendable)? = nil,
+	_ start: (UnsafeMutableRawPointer) -> Void
+) async throws {
+	try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+		let boxObj = DeadlineContinuationBox(continuation, retaining: retained)
+		if let deadline {
+			boxObj.arm(deadline: deadline)
+		}
+		start(Unmanaged.passRetained(boxObj).toOpaque())
+	}
+}
@@ -16,3 +16,11 @@ func toMilliseconds(_ d: Duration) -> Int {
 	let fracMs = Int(comps.attoseconds / 1_000_000_000_000_000)
 	return wholeSecMs &+ fracMs
 }
+
+@inline(__always)
+@inlinable
+func toNanoseconds(_ d: Duration) -> Int64 {
+	let comps = d.components
+	// 1 ns = 1_000_000_000 attoseconds
+	return comps.seconds &* 1_000_000_000 &+ comps.attoseconds / 1_000_000_000
+}
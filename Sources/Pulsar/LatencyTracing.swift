@@ -0,0 +1,139 @@
+import Foundation
+import Metrics
+import Synchronization
+
+/// Opt-in end-to-end latency instrumentation for consumers and listeners.
+///
+/// Sampled messages record the following swift-metrics timers, with `topic` and `subscription` dimensions:
+/// - `pulsar_consumer_broker_lag`: from the broker publish timestamp until the client received the message.
+/// - `pulsar_consumer_event_lag`: from the event timestamp, if set, until the client received the message.
+/// - `pulsar_listener_queue_time`: time the message waited in the ``Listener`` stream.
+/// - `pulsar_consumer_handler_duration`: from handing out the message until it was acknowledged.
+/// - `pulsar_consumer_ack_latency`: from acknowledging until the acknowledgement completed.
+///
+/// Broker and event lag compare timestamps of different hosts and are only as accurate as their clock synchronization.
+@frozen
+public struct LatencyTracingConfiguration: Sendable {
+	/// The fraction of received messages to trace, from `0` (off) to `1` (every message).
+	public var sampleRate: Double
+
+	/// Creates a new latency tracing configuration.
+	public init(sampleRate: Double = 0.01) {
+		self.sampleRate = sampleRate
+	}
+}
+
+/// A W3C trace context propagated in message properties.
+///
+/// Bind a context while creating messages to attach it to them, and read it back from received messages:
+///
+/// ```swift
+/// try await TraceContext.$current.withValue(TraceContext(traceparent: span.traceparent)) {
+/// 	try await producer.send(Message(content: "Hello"))
+/// }
+///
+/// for try await message in listener {
+/// 	let parent = message.traceContext
+/// }
+/// ```
+@frozen
+public struct TraceContext: Sendable, Hashable {
+	/// The property carrying the `traceparent` header.
+	public static let traceparentProperty = "traceparent"
+	/// The property carrying the `tracestate` header.
+	public static let tracestateProperty = "tracestate"
+
+	/// The context attached to messages created in the current task, if any.
+	@TaskLocal public static var current: TraceContext?
+
+	/// The `traceparent` header value.
+	public var traceparent: String
+	/// The `tracestate` header value (optional).
+	public var tracestate: String?
+
+	/// Creates a new trace context.
+	public init(traceparent: String, tracestate: String? = nil) {
+		self.traceparent = traceparent
+		self.tracestate = tracestate
+	}
+}
+
+extension Message {
+	/// The trace context propagated with the message, or `nil` if none was attached.
+	public var traceContext: TraceContext? {
+		guard let traceparent = property(TraceContext.traceparentProperty) else { return nil }
+		return TraceContext(traceparent: traceparent, tracestate: property(TraceContext.tracestateProperty))
+	}
+}
+
+/// Samples received messages and owns the latency timers of one topic and subscription.
+final class LatencyTracer: Sendable {
+	let brokerLag: Metrics.Timer
+	let eventLag: Metrics.Timer
+	let queueTime: Metrics.Timer
+	let handlerDuration: Metrics.Timer
+	let ackLatency: Metrics.Timer
+
+	private let sampleInterval: Int
+	private let counter = Atomic<Int>(0)
+
+	init?(configuration: LatencyTracingConfiguration?, topic: String, subscription: String) {
+		guard let configuration, configuration.sampleRate > 0 else { return nil }
+		// Deterministic 1-in-N sampling avoids a random number per message.
+		let interval = (1 / min(configuration.sampleRate, 1)).rounded()
+		self.sampleInterval = max(1, Int(min(interval, Double(Int32.max))))
+		let dimensions = [("topic", topic), ("subscription", subscription)]
+		self.brokerLag = Metrics.Timer(label: "pulsar_consumer_broker_lag", dimensions: dimensions)
+		self.eventLag = Metrics.Timer(label: "pulsar_consumer_event_lag", dimensions: dimensions)
+		self.queueTime = Metrics.Timer(label: "pulsar_listener_queue_time", dimensions: dimensions)
+		self.handlerDuration = Metrics.Timer(label: "pulsar_consumer_handler_duration", dimensions: dimensions)
+		self.ackLatency = Metrics.Timer(label: "pulsar_consumer_ack_latency", dimensions: dimensions)
+	}
+
+	/// Start a trace for a received message if it is sampled.
+	@inline(__always)
+	func sample() -> MessageTrace? {
+		guard counter.wrappingAdd(1, ordering: .relaxed).oldValue % sampleInterval == 0 else { return nil }
+		return MessageTrace(tracer: self)
+	}
+}
+
+/// The timestamps of one sampled message.
+final class MessageTrace: Sendable {
+	let tracer: LatencyTracer
+	let received: ContinuousClock.Instant
+	private let dequeued = Mutex<ContinuousClock.Instant?>(nil)
+
+	init(tracer: LatencyTracer) {
+		self.tracer = tracer
+		self.received = .now
+	}
+
+	func recordArrival(publishTimestamp: UInt64, eventTimestamp: UInt64?) {
+		let now = UInt64(Date().timeIntervalSince1970 * 1_000)
+		if publishTimestamp > 0, now >= publishTimestamp {
+			tracer.brokerLag.recordMilliseconds(now - publishTimestamp)
+		}
+		if let eventTimestamp, now >= eventTimestamp {
+			tracer.eventLag.recordMilliseconds(now - eventTimestamp)
+		}
+	}
+
+	func markDequeued() {
+		let now = ContinuousClock.now
+		dequeued.withLock { $0 = now }
+		tracer.queueTime.recordNanoseconds(toNanoseconds(now - received))
+	}
+
+	/// Records the handler duration and returns the start of the acknowledgement.
+	func beginAcknowledge() -> ContinuousClock.Instant {
+		let now = ContinuousClock.now
+		let handed = dequeued.withLock { $0 } ?? received
+		tracer.handlerDuration.recordNanoseconds(toNanoseconds(now - handed))
+		return now
+	}
+
+	func endAcknowledge(startedAt start: ContinuousClock.Instant) {
+		tracer.ackLatency.recordNanoseconds(toNanoseconds(ContinuousClock.now - start))
+	}
+}
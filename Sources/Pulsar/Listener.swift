@@ -24,6 +24,7 @@ public final class Listener<T: PulsarSchema>: Sendable, AsyncSequence {
 	let acknowledgementsAll: Counter
 	let acknowledgementsFailed: Counter
 	let acknowledgementsSuccess: Counter
+	let tracer: LatencyTracer?
 
 	final class ConsumerBox: @unchecked Sendable {
 		var consumer: Consumer<T>?
@@ -31,12 +32,27 @@ public final class Listener<T: PulsarSchema>: Sendable, AsyncSequence {
 	}
 
 	private let consumerState: Mutex<ConsumerBox>
+	private let drain = ListenerDrain()
 
-	public func makeAsyncIterator() -> AsyncThrowingStream<Message<T>, Error>.AsyncIterator {
-		stream.makeAsyncIterator()
+	/// The iterator of the listener's message stream.
+	public struct Iterator: AsyncIteratorProtocol {
+		var base: AsyncThrowingStream<Message<T>, Error>.AsyncIterator
+
+		/// Wait for the next message.
+		/// - Returns: The next message, or `nil` after the listener was closed.
+		public mutating func next() async throws -> Message<T>? {
+			guard let message = try await base.next() else { return nil }
+			message.trace?.markDequeued()
+			return message
+		}
 	}
 
-	init() {
+	/// Create an iterator over the received messages.
+	public func makeAsyncIterator() -> Iterator {
+		Iterator(base: stream.makeAsyncIterator())
+	}
+
+	init(tracer: LatencyTracer? = nil) {
 		var cont: AsyncThrowingStream<Message<T>, Error>.Continuation!
 		stream = AsyncThrowingStream { c in
 			cont = c
@@ -47,6 +63,7 @@ public final class Listener<T: PulsarSchema>: Sendable, AsyncSequence {
 		self.acknowledgementsAll = Counter(label: "pulsar_listener_acknowledgements_all")
 		self.acknowledgementsFailed = Counter(label: "pulsar_listener_acknowledgements_failed")
 		self.acknowledgementsSuccess = Counter(label: "pulsar_listener_acknowledgements_success")
+		self.tracer = tracer
 	}
 
 	func attach(consumer: Consumer<T>) {
@@ -59,6 +76,8 @@ public final class Listener<T: PulsarSchema>: Sendable, AsyncSequence {
 	/// - Parameter message: The message to acknowledge.
 	public func acknowledge(_ message: Message<T>) throws {
 		acknowledgementsAll.increment()
+		drain.begin()
+		defer { drain.end() }
 		do {
 			try consumerState.withLock { box in
 				guard let consumer = box.consumer else {
@@ -75,6 +94,8 @@ public final class Listener<T: PulsarSchema>: Sendable, AsyncSequence {
 
 	public func acknowledge(_ message: Message<T>) async throws {
 		acknowledgementsAll.increment()
+		drain.begin()
+		defer { drain.end() }
 		do {
 			let consumer = try consumerState.withLock { box -> Consumer in
 				guard let consumer = box.consumer else {
@@ -92,13 +113,46 @@ public final class Listener<T: PulsarSchema>: Sendable, AsyncSequence {
 	}
 
 	/// Close the listener.
+	///
+	/// Ends the message stream and blocks until the consumer is closed.
 	public func close() throws {
 		logger.info("Listener closed")
-		try consumerState.withLock { box in
-			if let consumer = box.consumer {
-				try consumer.close()
-			}
+		continuation.finish()
+		try detachConsumer()?.close()
+	}
+
+	/// Close the listener asynchronously.
+	///
+	/// Ends the message stream and closes the consumer without blocking the calling thread.
+	public func close() async throws {
+		logger.info("Listener closing")
+		continuation.finish()
+		try await detachConsumer()?.close()
+	}
+
+	/// Gracefully shut the listener down.
+	///
+	/// Ends the message stream and waits for acknowledgements already in flight, then flushes pending acknowledgements and
+	/// closes the consumer. Messages still buffered in the stream are not waited for, the broker redelivers them. If the
+	/// deadline passes first, the method throws ``PulsarError/timeout`` and the consumer is still closed in the background.
+	/// - Parameter deadline: The latest time to wait for the shutdown to complete.
+	public func shutdown(deadline: ContinuousClock.Instant) async throws {
+		logger.info("Listener shutting down")
+		continuation.finish()
+		do {
+			try await drain.wait(deadline: deadline)
+		} catch {
+			logger.warning("Listener shutdown deadline passed with acknowledgements in flight")
+		}
+		try await detachConsumer()?.shutdown(deadline: deadline)
+	}
+
+	// Hand the consumer out of the lock, so closing it never happens while holding it.
+	private func detachConsumer() -> Consumer<T>? {
+		consumerState.withLock { box in
+			let consumer = box.consumer
 			box.consumer = nil
+			return consumer
 		}
 	}
 
@@ -108,18 +162,67 @@ public final class Listener<T: PulsarSchema>: Sendable, AsyncSequence {
 		consumerState.withLock { box in
 			box.consumer?.counterAll.increment()
 		}
+		// Once the stream has ended the message is dropped, the broker redelivers it as it is never acknowledged.
 		continuation.yield(message)
 	}
 }
 
+/// Counts a listener's acknowledgements in flight, so shutdown can wait for them.
+final class ListenerDrain: Sendable {
+	private struct State {
+		var outstanding = 0
+		var waiters: [DeadlineContinuationBox] = []
+	}
+
+	private let state = Mutex(State())
+
+	func begin() {
+		state.withLock { $0.outstanding += 1 }
+	}
+
+	func end() {
+		let waiters = state.withLock { state -> [DeadlineContinuationBox] in
+			state.outstanding -= 1
+			guard state.outstanding == 0 else { return [] }
+			defer { state.waiters = [] }
+			return state.waiters
+		}
+		for waiter in waiters {
+			waiter.checkContinuation(result: 0, context: "ListenerDrain")
+		}
+	}
+
+	/// Wait until nothing is outstanding, throws ``PulsarError/timeout`` if the deadline passes first.
+	func wait(deadline: ContinuousClock.Instant) async throws {
+		try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+			let waiter = DeadlineContinuationBox(continuation)
+			waiter.arm(deadline: deadline)
+			let drained = state.withLock { state in
+				guard state.outstanding > 0 else { return true }
+				state.waiters.append(waiter)
+				return false
+			}
+			if drained {
+				waiter.checkContinuation(result: 0, context: "ListenerDrain")
+			}
+		}
+	}
+}
+
+extension Listener: GracefulShutdown {
+	func finishStream() {
+		continuation.finish()
+	}
+}
+
 // Protocol to handle messages in a type-erased way
-protocol MessageReceiver: AnyObject {
+protocol MessageReceiver: AnyObject, Sendable {
 	func receiveRawMessage(_ rawMsg: _Pulsar.Message, consumerPtr: UnsafeMutableRawPointer?)
 }
 
 extension Listener: MessageReceiver {
 	func receiveRawMessage(_ rawMsg: _Pulsar.Message, consumerPtr: UnsafeMutableRawPointer?) {
-		let message = Message<T>(rawMsg)
+		let message = Message<T>(rawMsg, trace: tracer?.sample())
 		receive(message: message, consumerPtr: consumerPtr)
 	}
 }
@@ -135,21 +238,18 @@ func messageListenerCallback(
 	// Copy the message to avoid capture issues
 	let rawMsg = msgPtr.assumingMemoryBound(to: _Pulsar.Message.self).pointee
 	let consumerAddress: UInt? = consumerPtr.map { UInt(bitPattern: $0) }
-	let ctxAddress = UInt(bitPattern: ctx)
+
+	// Resolve the listener while the C++ client still holds the context, the task then keeps its own reference.
+	guard let receiver = Unmanaged<AnyObject>.fromOpaque(ctx).takeUnretainedValue() as? MessageReceiver else {
+		Logger(label: "ListenerCallback").error("Context does not contain a valid MessageReceiver")
+		return
+	}
 
 	// We use an explicit @Sendable closure and trust that the C++ message copy is safe
 	Task.detached { @Sendable in
 		let logger: Logger = Logger(label: "ListenerCallback")
-		let restoredCtx = UnsafeMutableRawPointer(bitPattern: ctxAddress)!
 		let restoredConsumerPtr = consumerAddress.flatMap { UnsafeMutableRawPointer(bitPattern: $0) }
 
-		// Get the listener as MessageReceiver (type-erased)
-		let listenerObj = Unmanaged<AnyObject>.fromOpaque(restoredCtx).takeUnretainedValue()
-		guard let receiver = listenerObj as? MessageReceiver else {
-			logger.error("Context does not contain a valid MessageReceiver")
-			return
-		}
-
 		logger.debug("Listener received message via C++ callback")
 		receiver.receiveRawMessage(rawMsg, consumerPtr: restoredConsumerPtr)
 	}
@@ -5,27 +5,95 @@ import Foundation
 import Synchronization
 
 /// A message in Pulsar.
+///
+/// Metadata such as the key, properties and timestamps is read from the underlying C++ message on first access only,
+/// so routing or filtering on metadata never requires decoding ``content``.
 public final class Message<T: PulsarSchema>: Sendable {
 
 	final class Box: @unchecked Sendable {
 		var raw: _Pulsar.Message
+		var metadata = Metadata()
 		init(_ raw: _Pulsar.Message) { self.raw = raw }
 	}
 
+	// Lazily bridged metadata, `nil` until first accessed.
+	struct Metadata {
+		var partitionKey: String??
+		var orderingKey: String??
+		var topicName: String??
+		var properties: [String: String]?
+		var publishTimestamp: UInt64?
+		var eventTimestamp: UInt64??
+		var redeliveryCount: Int?
+		var messageId: MessageId?
+	}
+
+	// A borrowed view into the C++ message, valid as long as the message is alive.
+	struct BorrowedBytes: @unchecked Sendable {
+		let base: UnsafePointer<CChar>?
+		let count: Int
+
+		var buffer: UnsafeRawBufferPointer? {
+			base.map { UnsafeRawBufferPointer(start: $0, count: count) }
+		}
+	}
+
 	private let state: Mutex<Box>
+	private let isReceived: Bool
+	let trace: MessageTrace?
 
 	/// Creates a new message with the given content.
-	public init(content: T) throws {
+	/// - Parameters:
+	///   - content: The content of the message.
+	///   - key: The partition key used for routing and key-based batching (optional).
+	///   Ignored for ``SeparatedKeyValue`` content, which uses its own key.
+	///   - orderingKey: The ordering key used by `keyShared` subscriptions (optional).
+	///   - properties: Application defined properties attached to the message.
+	///   - eventTimestamp: The application event time in milliseconds since epoch (optional).
+	///
+	/// If a ``TraceContext/current`` trace context is bound, it is attached to the message properties.
+	public init(
+		content: T,
+		key: String? = nil,
+		orderingKey: String? = nil,
+		properties: [String: String] = [:],
+		eventTimestamp: UInt64? = nil
+	) throws {
 		var messageBuilder: _Pulsar.MessageBuilder = _Pulsar.MessageBuilder()
 		let contentData = try content.encode()
 		contentData.withUnsafeBytes { buffer in
 			messageBuilder.setContent(buffer.baseAddress!, size: buffer.count)
 		}
+		if let keyed = content as? any MessageKeySchema, let keyData = try keyed.messageKeyData {
+			messageBuilder.setPartitionKey(bytes: keyData)
+		} else if let key {
+			messageBuilder.setPartitionKey(key)
+		}
+		if let orderingKey {
+			messageBuilder.setOrderingKey(orderingKey)
+		}
+		for (name, value) in properties {
+			messageBuilder.setProperty(name, value: value)
+		}
+		if let eventTimestamp {
+			messageBuilder.setEventTimestamp(eventTimestamp)
+		}
+		if let traceContext = TraceContext.current, properties[TraceContext.traceparentProperty] == nil {
+			messageBuilder.setProperty(TraceContext.traceparentProperty, value: traceContext.traceparent)
+			if let tracestate = traceContext.tracestate {
+				messageBuilder.setProperty(TraceContext.tracestateProperty, value: tracestate)
+			}
+		}
 		self.state = Mutex(Box(messageBuilder.build()))
+		self.isReceived = false
+		self.trace = nil
 	}
 
-	init(_ raw: _Pulsar.Message) {
+	init(_ raw: _Pulsar.Message, trace: MessageTrace? = nil) {
 		self.state = Mutex(Box(raw))
+		self.isReceived = true
+		self.trace = trace
+		trace?.recordArrival(publishTimestamp: publishTimestamp, eventTimestamp: eventTimestamp)
 	}
 
 	@inline(__always)
@@ -37,22 +105,201 @@ public final class Message<T: PulsarSchema>: Sendable {
 	public var content: T {
 		get throws {
 			let data = try state.withLock { box in
-				var dataPtr: UnsafeMutableRawPointer?
-				let size = withUnsafePointer(to: box.raw) { msgPtr in
-					getDataFromMessage(UnsafeRawPointer(msgPtr), &dataPtr)
+				var dataPtr: UnsafeRawPointer?
+				var size = 0
+				let handle = withUnsafePointer(to: box.raw) { msgPtr in
+					Bridge_Msg_retainPayload(UnsafeRawPointer(msgPtr), &dataPtr, &size)
 				}
 
 				guard let dataPtr = dataPtr, size > 0 else {
+					Bridge_Msg_releasePayload(handle)
 					throw PulsarError.invalidMessage
 				}
 
-				defer {
-					free(dataPtr)
-				}
-
-				return Data(bytes: dataPtr, count: size)
+				// Borrow the payload instead of copying it, the handle keeps the C++ message alive until the data is freed.
+				let handleAddress = UInt(bitPattern: handle)
+				return Data(
+					bytesNoCopy: UnsafeMutableRawPointer(mutating: dataPtr),
+					count: size,
+					deallocator: .custom { _, _ in
+						Bridge_Msg_releasePayload(UnsafeMutableRawPointer(bitPattern: handleAddress))
+					}
+				)
+			}
+			if let keyed = T.self as? any MessageKeySchema.Type, keyed.usesMessageKey {
+				let messageKey = withUnsafeKey { bytes in bytes.map { Data($0) } }
+				return try keyed.decode(data, messageKey: messageKey) as! T
 			}
 			return try T.decode(data)
 		}
 	}
+
+	// MARK: - Metadata
+
+	/// The partition key of the message, or `nil` if none was set.
+	public var key: String? {
+		cached(\.partitionKey) { msgPtr in
+			guard Bridge_Msg_hasPartitionKey(msgPtr) else { return nil }
+			var size = 0
+			return borrowedString(Bridge_Msg_getPartitionKey(msgPtr, &size), size)
+		}
+	}
+
+	/// The ordering key of the message, or `nil` if none was set.
+	public var orderingKey: String? {
+		cached(\.orderingKey) { msgPtr in
+			guard Bridge_Msg_hasOrderingKey(msgPtr) else { return nil }
+			var size = 0
+			return borrowedString(Bridge_Msg_getOrderingKey(msgPtr, &size), size)
+		}
+	}
+
+	/// The topic the message was received from, or `nil` for messages that have not been received from a broker.
+	public var topicName: String? {
+		guard isReceived else { return nil }
+		return cached(\.topicName) { msgPtr in
+			var size = 0
+			return borrowedString(Bridge_Msg_getTopicName(msgPtr, &size), size)
+		}
+	}
+
+	/// The application defined properties of the message.
+	///
+	/// To look up a single property without bridging the whole map use ``property(_:)`` or ``withUnsafeProperty(_:_:)``.
+	public var properties: [String: String] {
+		cached(\.properties) { msgPtr in
+			var properties: [String: String] = [:]
+			withUnsafeMutablePointer(to: &properties) { propsPtr in
+				Bridge_Msg_forEachProperty(msgPtr, collectProperty, propsPtr)
+			}
+			return properties
+		}
+	}
+
+	/// The time the broker received the message in milliseconds since epoch, or `0` if it has not been published.
+	public var publishTimestamp: UInt64 {
+		cached(\.publishTimestamp) { msgPtr in
+			UInt64(Bridge_Msg_getPublishTimestamp(msgPtr))
+		}
+	}
+
+	/// The application event time in milliseconds since epoch, or `nil` if none was set.
+	public var eventTimestamp: UInt64? {
+		cached(\.eventTimestamp) { msgPtr in
+			let timestamp = UInt64(Bridge_Msg_getEventTimestamp(msgPtr))
+			return timestamp == 0 ? nil : timestamp
+		}
+	}
+
+	/// The number of times the message has been redelivered.
+	public var redeliveryCount: Int {
+		cached(\.redeliveryCount) { msgPtr in
+			Int(Bridge_Msg_getRedeliveryCount(msgPtr))
+		}
+	}
+
+	/// The ID of the message.
+	public var messageId: MessageId {
+		cached(\.messageId) { msgPtr in
+			var ledgerId: Int64 = 0
+			var entryId: Int64 = 0
+			var partition: Int32 = 0
+			var batchIndex: Int32 = 0
+			Bridge_Msg_getMessageId(msgPtr, &ledgerId, &entryId, &partition, &batchIndex)
+			return MessageId(ledgerId: ledgerId, entryId: entryId, partition: partition, batchIndex: batchIndex)
+		}
+	}
+
+	/// Get a single property of the message.
+	/// - Parameter name: The name of the property.
+	/// - Returns: The value, or `nil` if the property is not set.
+	public func property(_ name: String) -> String? {
+		withUnsafeProperty(name) { bytes in
+			bytes.map { String(decoding: $0, as: UTF8.self) }
+		}
+	}
+
+	/// Access the UTF-8 bytes of the partition key without copying them.
+	/// - Parameter body: A closure receiving the key bytes, or `nil` if no key was set. The buffer must not escape the closure.
+	/// - Returns: The value returned by `body`.
+	public func withUnsafeKey<R>(_ body: (UnsafeRawBufferPointer?) throws -> R) rethrows -> R {
+		let bytes = borrow { msgPtr in
+			guard Bridge_Msg_hasPartitionKey(msgPtr) else { return BorrowedBytes(base: nil, count: 0) }
+			var size = 0
+			let base = Bridge_Msg_getPartitionKey(msgPtr, &size)
+			return BorrowedBytes(base: base, count: size)
+		}
+		return try withExtendedLifetime(self) { try body(bytes.buffer) }
+	}
+
+	/// Access the UTF-8 bytes of the ordering key without copying them.
+	/// - Parameter body: A closure receiving the key bytes, or `nil` if no key was set. The buffer must not escape the closure.
+	/// - Returns: The value returned by `body`.
+	public func withUnsafeOrderingKey<R>(_ body: (UnsafeRawBufferPointer?) throws -> R) rethrows -> R {
+		let bytes = borrow { msgPtr in
+			guard Bridge_Msg_hasOrderingKey(msgPtr) else { return BorrowedBytes(base: nil, count: 0) }
+			var size = 0
+			let base = Bridge_Msg_getOrderingKey(msgPtr, &size)
+			return BorrowedBytes(base: base, count: size)
+		}
+		return try withExtendedLifetime(self) { try body(bytes.buffer) }
+	}
+
+	/// Access the UTF-8 bytes of a single property without copying them.
+	/// - Parameters:
+	///   - name: The name of the property.
+	///   - body: A closure receiving the value bytes, or `nil` if the property is not set. The buffer must not escape the closure.
+	/// - Returns: The value returned by `body`.
+	public func withUnsafeProperty<R>(_ name: String, _ body: (UnsafeRawBufferPointer?) throws -> R) rethrows -> R {
+		let bytes = borrow { msgPtr in
+			var size = 0
+			let base = name.withCString { Bridge_Msg_getProperty(msgPtr, $0, &size) }
+			return BorrowedBytes(base: base, count: size)
+		}
+		return try withExtendedLifetime(self) { try body(bytes.buffer) }
+	}
+
+	@inline(__always)
+	private func borrow(_ load: (UnsafeRawPointer) -> BorrowedBytes) -> BorrowedBytes {
+		state.withLock { box in
+			withUnsafePointer(to: &box.raw) { msgPtr in
+				load(UnsafeRawPointer(msgPtr))
+			}
+		}
+	}
+
+	@inline(__always)
+	private func cached<V: Sendable>(
+		_ field: WritableKeyPath<Metadata, V?>,
+		_ load: (UnsafeRawPointer) -> V
+	) -> V {
+		state.withLock { box in
+			if let value = box.metadata[keyPath: field] {
+				return value
+			}
+			let value = withUnsafePointer(to: &box.raw) { msgPtr in
+				load(UnsafeRawPointer(msgPtr))
+			}
+			box.metadata[keyPath: field] = value
+			return value
+		}
+	}
+}
+
+@inline(__always)
+private func borrowedString(_ base: UnsafePointer<CChar>?, _ count: Int) -> String {
+	guard let base, count > 0 else { return "" }
+	return String(decoding: UnsafeRawBufferPointer(start: base, count: count), as: UTF8.self)
+}
+
+private func collectProperty(
+	_ ctx: UnsafeMutableRawPointer?,
+	_ name: UnsafePointer<CChar>?,
+	_ nameSize: Int,
+	_ value: UnsafePointer<CChar>?,
+	_ valueSize: Int
+) {
+	guard let ctx else { return }
+	let properties = ctx.assumingMemoryBound(to: [String: String].self)
+	properties.pointee[borrowedString(name, nameSize)] = borrowedString(value, valueSize)
 }
@@ -1,5 +1,6 @@
 import Bridge
 import CxxPulsar
+import Foundation
 
 extension CxxPulsar.pulsar.MessageBuilder {
 
@@ -24,6 +25,30 @@ extension CxxPulsar.pulsar.MessageBuilder {
 		}
 	}
 
+	mutating func setPartitionKey(_ key: String) {
+		_withMutPtr { ptr in
+			key.withCString { Bridge_MB_setPartitionKey(ptr, $0) }
+		}
+	}
+
+	mutating func setPartitionKey(bytes: Data) {
+		_withMutPtr { ptr in
+			bytes.withUnsafeBytes { buffer in
+				Bridge_MB_setPartitionKeyBytes(ptr, buffer.baseAddress, buffer.count)
+			}
+		}
+	}
+
+	mutating func setOrderingKey(_ key: String) {
+		_withMutPtr { ptr in
+			key.withCString { Bridge_MB_setOrderingKey(ptr, $0) }
+		}
+	}
+
+	mutating func setEventTimestamp(_ millis: UInt64) {
+		_withMutPtr { Bridge_MB_setEventTimestamp($0, millis) }
+	}
+
 	mutating func setAllocatedContent(_ p: UnsafeMutableRawPointer, size: Int) {
 		_withMutPtr { Bridge_MB_setAllocatedContent($0, p, numericCast(size)) }
 	}
@@ -0,0 +1,25 @@
+/// The unique identifier of a message within a topic.
+@frozen
+public struct MessageId: Sendable, Hashable, CustomStringConvertible {
+	/// The ledger the message was stored in.
+	public let ledgerId: Int64
+	/// The entry within the ledger.
+	public let entryId: Int64
+	/// The partition of the topic, or `-1` for non-partitioned topics.
+	public let partition: Int32
+	/// The index within a batch, or `-1` if the message was not batched.
+	public let batchIndex: Int32
+
+	/// Creates a new message ID.
+	public init(ledgerId: Int64, entryId: Int64, partition: Int32 = -1, batchIndex: Int32 = -1) {
+		self.ledgerId = ledgerId
+		self.entryId = entryId
+		self.partition = partition
+		self.batchIndex = batchIndex
+	}
+
+	/// A human-readable description of the message ID.
+	public var description: String {
+		"(\(ledgerId),\(entryId),\(partition),\(batchIndex))"
+	}
+}
@@ -13,7 +13,10 @@ public final class Producer<T: PulsarSchema>: Sendable {
 		var raw: _Pulsar.Producer
 		init(_ raw: _Pulsar.Producer) { self.raw = raw }
 		deinit {
-			raw.close()
+			// Never block the releasing thread, flush and close in the background instead.
+			withUnsafeMutablePointer(to: &raw) { prodPtr in
+				pulsar_producer_flush_and_close_async(prodPtr)
+			}
 		}
 	}
 
@@ -76,8 +79,89 @@ public final class Producer<T: PulsarSchema>: Sendable {
 			}
 		}
 	}
+
+	/// Flush all pending messages synchronously.
+	///
+	/// This method will block until all messages sent before the call have been acknowledged by the server.
+	public func flush() throws {
+		let result = state.withLock { box in
+			box.raw.flush()
+		}
+		if result.rawValue != 0 { //ResultOk
+			throw PulsarError(cxx: result)
+		}
+	}
+
+	/// Flush all pending messages asynchronously.
+	///
+	/// Waits in a non-blocking fashion until all messages sent before the call have been acknowledged by the server.
+	public func flush() async throws {
+		try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+			let boxObj = ContinuationBox(continuation)
+			let ctx = Unmanaged.passRetained(boxObj).toOpaque()
+			state.withLock { box in
+				withUnsafeMutablePointer(to: &box.raw) { prodPtr in
+					pulsar_producer_flush_async(UnsafeMutableRawPointer(mutating: prodPtr), ctx)
+				}
+			}
+		}
+	}
+
+	/// Close the producer synchronously.
+	public func close() throws {
+		let result = state.withLock { box in
+			box.raw.close()
+		}
+		if result.rawValue != 0 { //ResultOk
+			throw PulsarError(cxx: result)
+		}
+	}
+
+	/// Close the producer asynchronously.
+	///
+	/// Messages that have not been acknowledged yet fail. Use ``shutdown(deadline:)`` to deliver them first.
+	public func close() async throws {
+		try await close(deadline: nil)
+	}
+
+	/// Gracefully shut the producer down.
+	///
+	/// Flushes all pending messages, then closes the producer. If the deadline passes first, the method throws
+	/// ``PulsarError/timeout`` and the producer is still closed in the background.
+	/// - Parameter deadline: The latest time to wait for the shutdown to complete.
+	public func shutdown(deadline: ContinuousClock.Instant) async throws {
+		var drainError: Error?
+		do {
+			try await awaitResult(deadline: deadline) { ctx in
+				withRawPointer { pulsar_producer_flush_async($0, ctx) }
+			}
+		} catch {
+			drainError = error
+		}
+		try await close(deadline: deadline)
+		if let drainError {
+			throw drainError
+		}
+	}
+
+	private func close(deadline: ContinuousClock.Instant?) async throws {
+		try await awaitResult(deadline: deadline) { ctx in
+			withRawPointer { pulsar_producer_close_async($0, ctx) }
+		}
+	}
+
+	@inline(__always)
+	private func withRawPointer(_ body: (UnsafeMutableRawPointer) -> Void) {
+		state.withLock { box in
+			withUnsafeMutablePointer(to: &box.raw) { prodPtr in
+				body(UnsafeMutableRawPointer(prodPtr))
+			}
+		}
+	}
 }
 
+extension Producer: GracefulShutdown {}
+
 @_cdecl("pulsar_swift_send_callback")
 func sendCallback(_ ctx: UnsafeMutableRawPointer?, _ result: Int32, _ messageIdPtr: UnsafeRawPointer?) {
 	let logger: Logger = Logger(label: "ProducerCallback")
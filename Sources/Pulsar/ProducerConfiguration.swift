@@ -181,6 +181,25 @@ public final class ProducerConfiguration: Sendable {
 		}
 	}
 
+	func renamed(_ name: String?) -> ProducerConfiguration {
+		ProducerConfiguration(
+			name: name,
+			sendTimeout: sendTimeout,
+			initialSequenceId: initialSequenceId,
+			compression: compression,
+			maxPendingMessages: maxPendingMessages,
+			maxPendingMessagesAcrossPartitions: maxPendingMessagesAcrossPartitions,
+			routingMode: routingMode,
+			hashingScheme: hashingScheme,
+			lazyStartPartitionedProducers: lazyStartPartitionedProducers,
+			blockIfQueueFull: blockIfQueueFull,
+			batching: batching,
+			chunking: chunking,
+			accessMode: accessMode,
+			properties: properties
+		)
+	}
+
 	func setCxxSchema<T: PulsarSchema>(_ schema: T.Type) throws {
 		let schemaInfo = try T.getSchemaInfo()
 		state.withLock { box in
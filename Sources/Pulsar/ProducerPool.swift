@@ -0,0 +1,272 @@
+import Foundation
+import Logging
+import Synchronization
+
+#if canImport(Darwin)
+	import Darwin
+#elseif canImport(Glibc)
+	import Glibc
+#elseif canImport(Musl)
+	import Musl
+#endif
+
+/// Strategy used by a ``ProducerPool`` to pick the producer for a message.
+@frozen
+public enum ProducerPoolRouting: Sendable {
+	/// Spread messages evenly across all producers.
+	case roundRobin
+	/// Pick the producer by the calling thread, so concurrent senders rarely contend on the same producer.
+	case threadAffinity
+	/// Pick the producer by the message key, keeping per-key ordering. Messages without a key are sent round-robin.
+	case key
+}
+
+/// A pool of producers sharding one logical topic.
+///
+/// A single ``Producer`` sends through one connection and one batch container. The pool owns several producers for the
+/// same topic, so one topic can absorb a higher publish rate from one process:
+///
+/// ```swift
+/// let pool: ProducerPool<Data> = try client.producerPool(for: "persistent://public/default/ingest", size: 8)
+/// try await pool.send(Message(content: payload))
+/// try await pool.flush()
+/// ```
+///
+/// By default all producers share one TCP connection per broker. Raising ``ClientConfiguration/connectionsPerBroker``
+/// lets them spread across several connections, but each producer picks one at random, so producers may still share a
+/// connection. Ordering is only guaranteed per producer, use ``ProducerPoolRouting/key`` to keep per-key ordering.
+public final class ProducerPool<T: PulsarSchema>: Sendable {
+
+	/// Message counts of a producer or of the whole pool.
+	@frozen
+	public struct Statistics: Sendable, Equatable {
+		/// The number of messages handed to the producer.
+		public var sent: Int
+		/// The number of messages acknowledged by the server.
+		public var succeeded: Int
+		/// The number of messages that failed.
+		public var failed: Int
+
+		/// The number of messages still waiting for the server.
+		public var pending: Int {
+			sent - succeeded - failed
+		}
+	}
+
+	final class Shard: Sendable {
+		let producer: Producer<T>
+		let sent = Atomic<Int>(0)
+		let succeeded = Atomic<Int>(0)
+		let failed = Atomic<Int>(0)
+
+		init(_ producer: Producer<T>) { self.producer = producer }
+
+		var statistics: Statistics {
+			Statistics(
+				sent: sent.load(ordering: .relaxed),
+				succeeded: succeeded.load(ordering: .relaxed),
+				failed: failed.load(ordering: .relaxed)
+			)
+		}
+	}
+
+	let logger = Logger(label: "ProducerPool")
+	private let shards: [Shard]
+	private let router: ShardRouter
+
+	/// The topic all producers of the pool send to.
+	public let topic: String
+	/// The routing strategy of the pool.
+	public let routing: ProducerPoolRouting
+
+	/// The number of producers in the pool.
+	public var size: Int {
+		shards.count
+	}
+
+	init(producers: [Producer<T>], topic: String, routing: ProducerPoolRouting) {
+		precondition(!producers.isEmpty, "A producer pool needs at least one producer")
+		self.shards = producers.map(Shard.init)
+		self.router = ShardRouter(routing: routing, shardCount: producers.count)
+		self.topic = topic
+		self.routing = routing
+	}
+
+	/// Send a message synchronously through one of the pooled producers.
+	/// - Parameter message: The message to send.
+	///
+	/// This method will block until the server acknowledged the message. Use the async overload for the non-blocking version.
+	public func send(_ message: Message<T>) throws {
+		let shard = selectShard(for: message)
+		shard.sent.add(1, ordering: .relaxed)
+		do {
+			try shard.producer.send(message)
+			shard.succeeded.add(1, ordering: .relaxed)
+		} catch {
+			shard.failed.add(1, ordering: .relaxed)
+			throw error
+		}
+	}
+
+	/// Send a message asynchronously through one of the pooled producers.
+	/// - Parameter message: The message to send.
+	public func send(_ message: Message<T>) async throws {
+		let shard = selectShard(for: message)
+		shard.sent.add(1, ordering: .relaxed)
+		do {
+			try await shard.producer.send(message)
+			shard.succeeded.add(1, ordering: .relaxed)
+		} catch {
+			shard.failed.add(1, ordering: .relaxed)
+			throw error
+		}
+	}
+
+	/// Flush all producers of the pool in parallel.
+	///
+	/// Waits until all messages sent before the call have been acknowledged by the server.
+	public func flush() async throws {
+		try await withThrowingTaskGroup(of: Void.self) { group in
+			for shard in shards {
+				group.addTask {
+					try await shard.producer.flush()
+				}
+			}
+			try await group.waitForAll()
+		}
+	}
+
+	/// Close all producers of the pool in parallel without blocking the calling thread.
+	///
+	/// All producers are closed even if one of them fails, the first error is rethrown.
+	public func close() async throws {
+		try await forEachProducer { producer in
+			try await producer.close()
+		}
+	}
+
+	/// Gracefully shut all producers of the pool down in parallel.
+	///
+	/// Each producer flushes its pending messages and closes. If the deadline passes first, the method throws
+	/// ``PulsarError/timeout`` and the remaining producers are still closed in the background.
+	/// - Parameter deadline: The latest time to wait for the shutdown to complete.
+	public func shutdown(deadline: ContinuousClock.Instant) async throws {
+		try await forEachProducer { producer in
+			try await producer.shutdown(deadline: deadline)
+		}
+	}
+
+	/// Close all producers of the pool.
+	///
+	/// All producers are closed even if one of them fails, the first error is rethrown.
+	public func close() throws {
+		var firstError: Error?
+		for shard in shards {
+			do {
+				try shard.producer.close()
+			} catch {
+				logger.error("Failed to close pooled producer on \(topic): \(error)")
+				firstError = firstError ?? error
+			}
+		}
+		if let firstError {
+			throw firstError
+		}
+	}
+
+	/// The aggregated message counts of all producers.
+	public var statistics: Statistics {
+		producerStatistics.reduce(Statistics(sent: 0, succeeded: 0, failed: 0)) { total, stats in
+			Statistics(
+				sent: total.sent + stats.sent,
+				succeeded: total.succeeded + stats.succeeded,
+				failed: total.failed + stats.failed
+			)
+		}
+	}
+
+	/// The message counts of each producer, in pool order.
+	public var producerStatistics: [Statistics] {
+		shards.map(\.statistics)
+	}
+
+	@inline(__always)
+	private func selectShard(for message: Message<T>) -> Shard {
+		shards[router.shardIndex(for: message)]
+	}
+
+	/// Run `body` for every producer in parallel, rethrowing the first error once all have completed.
+	private func forEachProducer(_ body: @escaping @Sendable (Producer<T>) async throws -> Void) async throws {
+		let firstError = await withTaskGroup(of: Error?.self) { group in
+			for shard in shards {
+				group.addTask {
+					do {
+						try await body(shard.producer)
+						return nil
+					} catch {
+						return error
+					}
+				}
+			}
+			var firstError: Error?
+			for await error in group {
+				if let error {
+					logger.error("Failed to close pooled producer on \(topic): \(error)")
+					firstError = firstError ?? error
+				}
+			}
+			return firstError
+		}
+		if let firstError {
+			throw firstError
+		}
+	}
+}
+
+/// Picks the shard of a ``ProducerPool`` for each message according to its routing strategy.
+final class ShardRouter: Sendable {
+	let routing: ProducerPoolRouting
+	let shardCount: Int
+	private let nextIndex = Atomic<Int>(0)
+
+	init(routing: ProducerPoolRouting, shardCount: Int) {
+		self.routing = routing
+		self.shardCount = shardCount
+	}
+
+	@inline(__always)
+	func shardIndex<T: PulsarSchema>(for message: Message<T>) -> Int {
+		guard shardCount > 1 else { return 0 }
+		let index: Int
+		switch routing {
+			case .roundRobin:
+				index = nextIndex.wrappingAdd(1, ordering: .relaxed).oldValue
+			case .threadAffinity:
+				index = mix(currentThreadID())
+			case .key:
+				let keyHash: Int? = message.withUnsafeKey { bytes in
+					guard let bytes else { return nil }
+					var hasher = Hasher()
+					hasher.combine(bytes: bytes)
+					return hasher.finalize()
+				}
+				index = keyHash ?? nextIndex.wrappingAdd(1, ordering: .relaxed).oldValue
+		}
+		return Int(UInt(bitPattern: index) % UInt(shardCount))
+	}
+}
+
+@inline(__always)
+private func currentThreadID() -> UInt {
+	#if canImport(Darwin)
+		UInt(bitPattern: pthread_self())
+	#else
+		UInt(pthread_self())
+	#endif
+}
+
+// Thread IDs are aligned addresses, spread their bits before taking the modulo.
+@inline(__always)
+private func mix(_ value: UInt) -> Int {
+	Int(bitPattern: (value &* 0x9E37_79B9_7F4A_7C15) >> 16)
+}
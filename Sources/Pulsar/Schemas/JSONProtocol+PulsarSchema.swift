@@ -0,0 +1,82 @@
+import Foundation
+import Synchronization
+
+/// Protocol for `Codable` types sent as JSON messages.
+///
+/// Conform a type to both ``PulsarSchema`` and `JSONProtocol` to use the JSON schema:
+///
+/// ```swift
+/// struct Order: PulsarSchema, JSONProtocol {
+/// 	var id: String
+/// 	var amount: Double
+/// 	var note: String?
+/// }
+///
+/// let producer: Producer<Order> = try client.producer(for: "persistent://public/default/orders")
+/// ```
+///
+/// Messages are encoded and decoded with the client's own streaming JSON coder instead of Foundation's `JSONEncoder`
+/// and `JSONDecoder`. Dates use milliseconds since epoch and `Data` base64, the Jackson defaults of the Java client, so
+/// messages interoperate with Java producers and consumers using `Schema.JSON`.
+public protocol JSONProtocol: Codable, Sendable {
+	/// The Avro record definition registered for the JSON schema, or `nil` to derive it from the `Codable` conformance.
+	static var jsonSchemaDefinition: String? { get }
+}
+
+extension JSONProtocol {
+	/// Derives the schema definition from the `Codable` conformance.
+	public static var jsonSchemaDefinition: String? { nil }
+}
+
+private let jsonSchemaInfoCache = Mutex<[ObjectIdentifier: SchemaInfo]>([:])
+
+extension PulsarSchema where Self: JSONProtocol {
+
+	/// The schema type for JSON protocols.
+	public var schemaType: PulsarSchemaType {
+		.json
+	}
+	/// The schema definition.
+	public var schema: String? {
+		get throws {
+			try Self.getSchemaInfo().schema
+		}
+	}
+	/// The schema information.
+	public var schemaInfo: SchemaInfo {
+		get throws {
+			try Self.getSchemaInfo()
+		}
+	}
+
+	/// Encodes the JSON protocol to data.
+	public func encode() throws -> Data {
+		try JSONStreamEncoder.encode(self)
+	}
+	/// Decodes data to a JSON protocol instance.
+	public static func decode(_ data: Data) throws -> Self {
+		try JSONTapeDecoder.decode(Self.self, from: data)
+	}
+
+	/// Gets the schema information for a JSON protocol, generated once per type.
+	public static func getSchemaInfo() throws -> SchemaInfo {
+		let id = ObjectIdentifier(Self.self)
+		if let cached = jsonSchemaInfoCache.withLock({ $0[id] }) {
+			return cached
+		}
+		let definition: String
+		do {
+			definition = try Self.jsonSchemaDefinition ?? JSONSchemaDefinition.definition(for: Self.self)
+		} catch {
+			throw PulsarError.invalidSchema
+		}
+		let info = SchemaInfo(
+			schemaType: .json,
+			name: JSONSchemaDefinition.recordName(for: Self.self),
+			schema: definition,
+			properties: JSONSchemaDefinition.properties
+		)
+		jsonSchemaInfoCache.withLock { $0[id] = info }
+		return info
+	}
+}
@@ -0,0 +1,474 @@
+import Foundation
+
+/// Derives the schema definition of a JSON schema from a `Decodable` conformance.
+///
+/// Like the Java client, JSON schemas are described with an Avro record definition. The structure is discovered by
+/// decoding a placeholder value and recording every requested key and type, so it follows the `CodingKeys` of the type.
+///
+/// Fields follow the rules of Java's `ReflectData.AllowNull`, which `Schema.JSON` uses: every field except booleans and
+/// fixed width numbers, which Java holds in primitives, becomes a `["null", type]` union with a `null` default. This
+/// includes `Date`, `Decimal`, `Data`, `UUID` and `URL` fields, which Java models as objects.
+///
+/// Types whose decoding rejects placeholder values, for example `String` backed enums, have to provide
+/// ``JSONProtocol/jsonSchemaDefinition`` themselves.
+enum JSONSchemaDefinition {
+	/// The schema properties the Java client registers along with JSON schemas.
+	static let properties = ["__alwaysAllowNull": "true", "__jsr310ConversionEnabled": "false"]
+
+	static func definition<T: Decodable>(for type: T.Type) throws -> String {
+		let inference = SchemaInference()
+		let (_, schema) = try inference.placeholder(T.self)
+		var emitted: Set<String> = []
+		let object = schema.jsonObject(emitted: &emitted)
+		let data = try JSONSerialization.data(withJSONObject: object, options: [.sortedKeys, .fragmentsAllowed])
+		return String(decoding: data, as: UTF8.self)
+	}
+
+	/// The Avro record name for a Swift type.
+	static func recordName(for type: Any.Type) -> String {
+		let name = String(describing: type).map { $0.isLetter || $0.isNumber || $0 == "_" ? $0 : "_" }
+		guard let first = name.first, !first.isNumber else { return "_" + String(name) }
+		return String(name)
+	}
+}
+
+indirect enum AvroSchemaNode {
+	case primitive(String)
+	case logical(String, logicalType: String)
+	/// A number Java models as an object, like `BigDecimal`, so fields of it are nullable.
+	case boxed(AvroSchemaNode)
+	case record(name: String, fields: [(name: String, schema: AvroSchemaNode)])
+	case array(AvroSchemaNode)
+	case map(AvroSchemaNode)
+	case nullable(AvroSchemaNode)
+	case reference(String)
+	/// The schema of a nested container, resolved once the container has been decoded.
+	case recorded(SchemaRecorder)
+
+	func jsonObject(emitted: inout Set<String>) -> Any {
+		switch self {
+			case .primitive(let type):
+				return type
+			case .logical(let type, let logicalType):
+				return ["type": type, "logicalType": logicalType]
+			case .boxed(let schema):
+				return schema.jsonObject(emitted: &emitted)
+			case .record(let name, let fields):
+				// Avro names can only be defined once, later uses refer to the first definition.
+				guard emitted.insert(name).inserted else { return name }
+				let fieldObjects: [[String: Any]] = fields.map { field in
+					let schema = field.schema.allowingNull
+					var object: [String: Any] = ["name": field.name, "type": schema.jsonObject(emitted: &emitted)]
+					if case .nullable = schema {
+						object["default"] = NSNull()
+					}
+					return object
+				}
+				return ["type": "record", "name": name, "fields": fieldObjects]
+			case .array(let items):
+				return ["type": "array", "items": items.jsonObject(emitted: &emitted)]
+			case .map(let values):
+				return ["type": "map", "values": values.jsonObject(emitted: &emitted)]
+			case .nullable(let schema):
+				if case .nullable = schema {
+					return schema.jsonObject(emitted: &emitted)
+				}
+				return ["null", schema.jsonObject(emitted: &emitted)]
+			case .reference(let name):
+				return name
+			case .recorded(let recorder):
+				return recorder.schema.jsonObject(emitted: &emitted)
+		}
+	}
+
+	/// The field schema as `ReflectData.AllowNull` derives it, nullable unless it is a Java primitive.
+	var allowingNull: AvroSchemaNode {
+		switch self {
+			case .primitive("boolean"), .primitive("int"), .primitive("long"), .primitive("float"), .primitive("double"),
+				.nullable:
+				return self
+			case .recorded(let recorder):
+				return recorder.schema.allowingNull
+			default:
+				return .nullable(self)
+		}
+	}
+}
+
+// MARK: - Inference
+
+final class SchemaInference {
+	static let maxDepth = 64
+
+	private var inProgress: Set<ObjectIdentifier> = []
+	private var depth = 0
+
+	/// Returns a placeholder value of `type` and its schema.
+	func placeholder<T: Decodable>(_ type: T.Type) throws -> (T, AvroSchemaNode) {
+		if let known = Self.knownPlaceholder(T.self) {
+			return (known.value as! T, known.schema)
+		}
+		guard depth < Self.maxDepth, !inProgress.contains(ObjectIdentifier(T.self)) else {
+			throw PulsarError.invalidSchema
+		}
+		depth += 1
+		inProgress.insert(ObjectIdentifier(T.self))
+		defer {
+			depth -= 1
+			inProgress.remove(ObjectIdentifier(T.self))
+		}
+		let recorder = SchemaRecorder(name: JSONSchemaDefinition.recordName(for: T.self))
+		let value = try T(from: SchemaInferenceDecoder(inference: self, recorder: recorder, codingPath: []))
+		return (value, recorder.schema)
+	}
+
+	/// Returns whether `type` is being inferred, so that an optional reference to it must not recurse.
+	func isInProgress(_ type: Any.Type) -> Bool {
+		inProgress.contains(ObjectIdentifier(type))
+	}
+
+	private static func knownPlaceholder(_ type: Any.Type) -> (value: Any, schema: AvroSchemaNode)? {
+		switch type {
+			case is String.Type: return ("", .primitive("string"))
+			case is Bool.Type: return (false, .primitive("boolean"))
+			case is Int8.Type: return (Int8(0), .primitive("int"))
+			case is Int16.Type: return (Int16(0), .primitive("int"))
+			case is Int32.Type: return (Int32(0), .primitive("int"))
+			case is UInt8.Type: return (UInt8(0), .primitive("int"))
+			case is UInt16.Type: return (UInt16(0), .primitive("int"))
+			case is Int.Type: return (0, .primitive("long"))
+			case is Int64.Type: return (Int64(0), .primitive("long"))
+			case is UInt.Type: return (UInt(0), .primitive("long"))
+			case is UInt32.Type: return (UInt32(0), .primitive("long"))
+			case is UInt64.Type: return (UInt64(0), .primitive("long"))
+			case is Float.Type: return (Float(0), .primitive("float"))
+			case is Double.Type: return (0.0, .primitive("double"))
+			case is Decimal.Type: return (Decimal(0), .boxed(.primitive("double")))
+			case is Data.Type: return (Data(), .primitive("bytes"))
+			case is Date.Type: return (Date(timeIntervalSince1970: 0), .logical("long", logicalType: "timestamp-millis"))
+			case is UUID.Type: return (UUID(), .primitive("string"))
+			case is URL.Type: return (URL(string: "http://localhost")!, .primitive("string"))
+			default: return nil
+		}
+	}
+}
+
+/// Collects the schema of one value while it is decoded from placeholders.
+final class SchemaRecorder {
+	let name: String
+	var fields: [(name: String, schema: AvroSchemaNode)] = []
+	var items: AvroSchemaNode?
+	var single: AvroSchemaNode?
+	var isKeyed = false
+	var isUnkeyed = false
+	var isMap = false
+
+	init(name: String) {
+		self.name = name
+	}
+
+	func record(field name: String, _ schema: AvroSchemaNode) {
+		if let index = fields.firstIndex(where: { $0.name == name }) {
+			fields[index].schema = schema
+		} else {
+			fields.append((name, schema))
+		}
+	}
+
+	var schema: AvroSchemaNode {
+		if isMap {
+			return .map(fields.first?.schema ?? .primitive("string"))
+		}
+		if isKeyed {
+			return .record(name: name, fields: fields)
+		}
+		if isUnkeyed {
+			return .array(items ?? .primitive("string"))
+		}
+		return single ?? .record(name: name, fields: [])
+	}
+}
+
+struct SchemaInferenceDecoder: Decoder {
+	let inference: SchemaInference
+	let recorder: SchemaRecorder
+	let codingPath: [any CodingKey]
+	var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+	func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+		recorder.isKeyed = true
+		return KeyedDecodingContainer(SchemaInferenceKeyedContainer<Key>(decoder: self))
+	}
+
+	func unkeyedContainer() throws -> any UnkeyedDecodingContainer {
+		recorder.isUnkeyed = true
+		return SchemaInferenceUnkeyedContainer(decoder: self)
+	}
+
+	func singleValueContainer() throws -> any SingleValueDecodingContainer {
+		SchemaInferenceSingleValueContainer(decoder: self)
+	}
+}
+
+struct SchemaInferenceKeyedContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+	let decoder: SchemaInferenceDecoder
+	var codingPath: [any CodingKey] { decoder.codingPath }
+
+	/// Dictionaries decode the values of `allKeys`, a single placeholder key reveals the value type.
+	var allKeys: [Key] {
+		guard let key = Key(stringValue: "0") else { return [] }
+		decoder.recorder.isMap = true
+		return [key]
+	}
+
+	func contains(_ key: Key) -> Bool { true }
+
+	func decodeNil(forKey key: Key) throws -> Bool { false }
+
+	func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+		try decodePlaceholder(type, forKey: key)
+	}
+
+	private func decodePlaceholder<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+		let (value, schema) = try decoder.inference.placeholder(type)
+		decoder.recorder.record(field: key.stringValue, schema)
+		return value
+	}
+
+	func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: String.Type, forKey key: Key) throws -> String { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: Float.Type, forKey key: Key) throws -> Float { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: Int.Type, forKey key: Key) throws -> Int { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try decodePlaceholder(type, forKey: key) }
+
+	func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try decodePlaceholder(type, forKey: key) }
+
+	func decodeIfPresent<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Bool.Type, forKey key: Key) throws -> Bool? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: String.Type, forKey key: Key) throws -> String? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Double.Type, forKey key: Key) throws -> Double? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Float.Type, forKey key: Key) throws -> Float? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int.Type, forKey key: Key) throws -> Int? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int8.Type, forKey key: Key) throws -> Int8? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int16.Type, forKey key: Key) throws -> Int16? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int32.Type, forKey key: Key) throws -> Int32? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int64.Type, forKey key: Key) throws -> Int64? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt.Type, forKey key: Key) throws -> UInt? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt8.Type, forKey key: Key) throws -> UInt8? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt16.Type, forKey key: Key) throws -> UInt16? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt32.Type, forKey key: Key) throws -> UInt32? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt64.Type, forKey key: Key) throws -> UInt64? {
+		try decodeOptionalPlaceholder(type, forKey: key)
+	}
+
+	private func decodeOptionalPlaceholder<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T? {
+		if decoder.inference.isInProgress(type) {
+			decoder.recorder.record(field: key.stringValue, .nullable(.reference(JSONSchemaDefinition.recordName(for: type))))
+			return nil
+		}
+		let (value, schema) = try decoder.inference.placeholder(type)
+		decoder.recorder.record(field: key.stringValue, .nullable(schema))
+		return value
+	}
+
+	func nestedContainer<NestedKey: CodingKey>(
+		keyedBy type: NestedKey.Type,
+		forKey key: Key
+	) throws -> KeyedDecodingContainer<NestedKey> {
+		try nestedDecoder(forKey: key).container(keyedBy: type)
+	}
+
+	func nestedUnkeyedContainer(forKey key: Key) throws -> any UnkeyedDecodingContainer {
+		try nestedDecoder(forKey: key).unkeyedContainer()
+	}
+
+	func superDecoder() throws -> any Decoder {
+		decoder
+	}
+
+	func superDecoder(forKey key: Key) throws -> any Decoder {
+		nestedDecoder(forKey: key)
+	}
+
+	/// A decoder whose recorded schema becomes the field for `key`.
+	private func nestedDecoder(forKey key: Key) -> SchemaInferenceDecoder {
+		let recorder = SchemaRecorder(name: decoder.recorder.name + "_" + JSONSchemaDefinition.recordName(for: Key.self))
+		decoder.recorder.record(field: key.stringValue, .recorded(recorder))
+		return SchemaInferenceDecoder(inference: decoder.inference, recorder: recorder, codingPath: codingPath + [key])
+	}
+}
+
+struct SchemaInferenceUnkeyedContainer: UnkeyedDecodingContainer {
+	let decoder: SchemaInferenceDecoder
+	var codingPath: [any CodingKey] { decoder.codingPath }
+	var count: Int? { 1 }
+	var isAtEnd: Bool { currentIndex >= 1 }
+	private(set) var currentIndex = 0
+
+	init(decoder: SchemaInferenceDecoder) {
+		self.decoder = decoder
+	}
+
+	mutating func decodeNil() throws -> Bool { false }
+
+	mutating func decode<T: Decodable>(_ type: T.Type) throws -> T {
+		try decodePlaceholder(type)
+	}
+
+	mutating func decode(_ type: Bool.Type) throws -> Bool { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: String.Type) throws -> String { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: Double.Type) throws -> Double { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: Float.Type) throws -> Float { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: Int.Type) throws -> Int { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: Int8.Type) throws -> Int8 { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: Int16.Type) throws -> Int16 { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: Int32.Type) throws -> Int32 { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: Int64.Type) throws -> Int64 { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: UInt.Type) throws -> UInt { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: UInt8.Type) throws -> UInt8 { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: UInt16.Type) throws -> UInt16 { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: UInt32.Type) throws -> UInt32 { try decodePlaceholder(type) }
+
+	mutating func decode(_ type: UInt64.Type) throws -> UInt64 { try decodePlaceholder(type) }
+
+	private mutating func decodePlaceholder<T: Decodable>(_ type: T.Type) throws -> T {
+		currentIndex += 1
+		let (value, schema) = try decoder.inference.placeholder(type)
+		decoder.recorder.items = schema
+		return value
+	}
+
+	mutating func nestedContainer<NestedKey: CodingKey>(keyedBy type: NestedKey.Type) throws -> KeyedDecodingContainer<NestedKey> {
+		throw PulsarError.invalidSchema
+	}
+
+	mutating func nestedUnkeyedContainer() throws -> any UnkeyedDecodingContainer {
+		throw PulsarError.invalidSchema
+	}
+
+	mutating func superDecoder() throws -> any Decoder {
+		throw PulsarError.invalidSchema
+	}
+}
+
+struct SchemaInferenceSingleValueContainer: SingleValueDecodingContainer {
+	let decoder: SchemaInferenceDecoder
+	var codingPath: [any CodingKey] { decoder.codingPath }
+
+	func decodeNil() -> Bool {
+		// Reached through `Optional.init(from:)`, the wrapped value is decoded next.
+		false
+	}
+
+	func decode<T: Decodable>(_ type: T.Type) throws -> T {
+		try decodePlaceholder(type)
+	}
+
+	func decode(_ type: Bool.Type) throws -> Bool { try decodePlaceholder(type) }
+
+	func decode(_ type: String.Type) throws -> String { try decodePlaceholder(type) }
+
+	func decode(_ type: Double.Type) throws -> Double { try decodePlaceholder(type) }
+
+	func decode(_ type: Float.Type) throws -> Float { try decodePlaceholder(type) }
+
+	func decode(_ type: Int.Type) throws -> Int { try decodePlaceholder(type) }
+
+	func decode(_ type: Int8.Type) throws -> Int8 { try decodePlaceholder(type) }
+
+	func decode(_ type: Int16.Type) throws -> Int16 { try decodePlaceholder(type) }
+
+	func decode(_ type: Int32.Type) throws -> Int32 { try decodePlaceholder(type) }
+
+	func decode(_ type: Int64.Type) throws -> Int64 { try decodePlaceholder(type) }
+
+	func decode(_ type: UInt.Type) throws -> UInt { try decodePlaceholder(type) }
+
+	func decode(_ type: UInt8.Type) throws -> UInt8 { try decodePlaceholder(type) }
+
+	func decode(_ type: UInt16.Type) throws -> UInt16 { try decodePlaceholder(type) }
+
+	func decode(_ type: UInt32.Type) throws -> UInt32 { try decodePlaceholder(type) }
+
+	func decode(_ type: UInt64.Type) throws -> UInt64 { try decodePlaceholder(type) }
+
+	private func decodePlaceholder<T: Decodable>(_ type: T.Type) throws -> T {
+		let (value, schema) = try decoder.inference.placeholder(type)
+		decoder.recorder.single = schema
+		return value
+	}
+}
@@ -0,0 +1,625 @@
+import Foundation
+import Synchronization
+
+/// Encodes `Encodable` values as JSON directly into a reusable byte buffer.
+///
+/// Unlike Foundation's `JSONEncoder`, no intermediate value tree is built: containers are written as they are encoded and
+/// closed lazily once their parent continues. Containers must be filled in order; writing to a container after a
+/// sibling has been started throws an `EncodingError`.
+///
+/// Dates are encoded as milliseconds since epoch and `Data` as base64, matching the Jackson defaults of the Java client.
+enum JSONStreamEncoder {
+	static func encode<T: Encodable>(_ value: T) throws -> Data {
+		let writer = JSONWriter.take()
+		defer { JSONWriter.recycle(writer) }
+		try writer.writeValue(value, codingPath: [])
+		try writer.finish()
+		return Data(writer.bytes)
+	}
+}
+
+private let writerPool = Mutex<[JSONWriter]>([])
+
+// Only ever used by one encoding at a time, handed over through the pool.
+final class JSONWriter: @unchecked Sendable {
+	struct Frame {
+		let id: Int
+		let isObject: Bool
+		var isEmpty: Bool
+	}
+
+	static let maxPooledWriters = 16
+	static let maxPooledCapacity = 1 << 20
+
+	var bytes: [UInt8] = []
+	var frames: [Frame] = []
+	var nextFrameID = 0
+	var error: Error?
+
+	static func take() -> JSONWriter {
+		writerPool.withLock { pool in pool.popLast() } ?? JSONWriter()
+	}
+
+	static func recycle(_ writer: JSONWriter) {
+		guard writer.bytes.capacity <= maxPooledCapacity else { return }
+		writer.bytes.removeAll(keepingCapacity: true)
+		writer.frames.removeAll(keepingCapacity: true)
+		writer.error = nil
+		writerPool.withLock { pool in
+			if pool.count < maxPooledWriters {
+				pool.append(writer)
+			}
+		}
+	}
+
+	func finish() throws {
+		if let error {
+			throw error
+		}
+		closeFrames(downTo: 0)
+	}
+
+	// MARK: - Containers
+
+	func openFrame(isObject: Bool) -> Int {
+		let id = nextFrameID
+		nextFrameID &+= 1
+		frames.append(Frame(id: id, isObject: isObject, isEmpty: true))
+		bytes.append(isObject ? UInt8(ascii: "{") : UInt8(ascii: "["))
+		return id
+	}
+
+	func closeFrames(downTo depth: Int) {
+		while frames.count > depth {
+			let frame = frames.removeLast()
+			bytes.append(frame.isObject ? UInt8(ascii: "}") : UInt8(ascii: "]"))
+		}
+	}
+
+	func frameIndex(of id: Int) -> Int? {
+		frames.lastIndex { $0.id == id }
+	}
+
+	/// Starts a new entry in the container `id`, writing the separator and key.
+	func beginEntry(in id: Int, key: String?, codingPath: [any CodingKey]) throws {
+		guard let index = frameIndex(of: id) else {
+			throw EncodingError.invalidValue(
+				key ?? "",
+				EncodingError.Context(
+					codingPath: codingPath,
+					debugDescription: "Container was written to after a sibling container had been started."
+				)
+			)
+		}
+		closeFrames(downTo: index + 1)
+		if frames[index].isEmpty {
+			frames[index].isEmpty = false
+		} else {
+			bytes.append(UInt8(ascii: ","))
+		}
+		if let key {
+			writeString(key)
+			bytes.append(UInt8(ascii: ":"))
+		}
+	}
+
+	/// Like ``beginEntry(in:key:codingPath:)`` for non-throwing encoder APIs, the error is rethrown by ``finish()``.
+	func beginEntryDeferred(in id: Int, key: String?, codingPath: [any CodingKey]) {
+		do {
+			try beginEntry(in: id, key: key, codingPath: codingPath)
+		} catch {
+			self.error = self.error ?? error
+		}
+	}
+
+	// MARK: - Values
+
+	func writeValue<T: Encodable>(_ value: T, codingPath: [any CodingKey]) throws {
+		if T.self == String.self {
+			writeString(value as! String)
+		} else if T.self == Int.self {
+			writeInteger(value as! Int)
+		} else if T.self == Double.self {
+			try writeFloatingPoint(value as! Double, codingPath: codingPath)
+		} else if T.self == Bool.self {
+			writeBool(value as! Bool)
+		} else if let date = value as? Date {
+			writeInteger(Int64((date.timeIntervalSince1970 * 1_000).rounded()))
+		} else if let data = value as? Data {
+			writeString(data.base64EncodedString())
+		} else if let url = value as? URL {
+			writeString(url.absoluteString)
+		} else if let decimal = value as? Decimal {
+			bytes.append(contentsOf: decimal.description.utf8)
+		} else {
+			let depth = frames.count
+			let start = bytes.count
+			let encoder = JSONStreamEncoderImpl(writer: self, depth: depth, codingPath: codingPath)
+			try value.encode(to: encoder)
+			if bytes.count == start {
+				// Matches Foundation, which encodes a value without any containers as an empty object.
+				bytes.append(contentsOf: "{}".utf8)
+			}
+		}
+	}
+
+	func writeNull() {
+		bytes.append(contentsOf: "null".utf8)
+	}
+
+	func writeBool(_ value: Bool) {
+		bytes.append(contentsOf: value ? "true".utf8 : "false".utf8)
+	}
+
+	func writeInteger<I: FixedWidthInteger>(_ value: I) {
+		if value == 0 {
+			bytes.append(UInt8(ascii: "0"))
+			return
+		}
+		if value < 0 {
+			bytes.append(UInt8(ascii: "-"))
+		}
+		var magnitude = value.magnitude
+		let start = bytes.count
+		while magnitude > 0 {
+			let (quotient, remainder) = magnitude.quotientAndRemainder(dividingBy: 10)
+			bytes.append(UInt8(ascii: "0") &+ UInt8(truncatingIfNeeded: remainder))
+			magnitude = quotient
+		}
+		bytes[start...].reverse()
+	}
+
+	func writeFloatingPoint<F: BinaryFloatingPoint & LosslessStringConvertible>(
+		_ value: F,
+		codingPath: [any CodingKey]
+	) throws {
+		guard value.isFinite else {
+			throw EncodingError.invalidValue(
+				value,
+				EncodingError.Context(codingPath: codingPath, debugDescription: "Unable to encode \(value) as JSON number.")
+			)
+		}
+		bytes.append(contentsOf: value.description.utf8)
+	}
+
+	func writeString(_ value: String) {
+		var value = value
+		bytes.append(UInt8(ascii: "\""))
+		value.withUTF8 { utf8 in
+			var runStart = 0
+			for index in 0 ..< utf8.count {
+				let byte = utf8[index]
+				guard byte < 0x20 || byte == UInt8(ascii: "\"") || byte == UInt8(ascii: "\\") else { continue }
+				bytes.append(contentsOf: UnsafeBufferPointer(rebasing: utf8[runStart ..< index]))
+				writeEscaped(byte)
+				runStart = index + 1
+			}
+			bytes.append(contentsOf: UnsafeBufferPointer(rebasing: utf8[runStart...]))
+		}
+		bytes.append(UInt8(ascii: "\""))
+	}
+
+	private func writeEscaped(_ byte: UInt8) {
+		bytes.append(UInt8(ascii: "\\"))
+		switch byte {
+			case UInt8(ascii: "\""), UInt8(ascii: "\\"): bytes.append(byte)
+			case UInt8(ascii: "\n"): bytes.append(UInt8(ascii: "n"))
+			case UInt8(ascii: "\r"): bytes.append(UInt8(ascii: "r"))
+			case UInt8(ascii: "\t"): bytes.append(UInt8(ascii: "t"))
+			case 0x08: bytes.append(UInt8(ascii: "b"))
+			case 0x0C: bytes.append(UInt8(ascii: "f"))
+			default:
+				let hex = Array("0123456789abcdef".utf8)
+				bytes.append(contentsOf: "u00".utf8)
+				bytes.append(hex[Int(byte >> 4)])
+				bytes.append(hex[Int(byte & 0xF)])
+		}
+	}
+}
+
+// MARK: - Encoder
+
+final class JSONStreamEncoderImpl: Encoder {
+	let writer: JSONWriter
+	/// The number of frames open when this encoder's value slot was started.
+	let depth: Int
+	let codingPath: [any CodingKey]
+	var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+	private var frameID: Int?
+
+	init(writer: JSONWriter, depth: Int, codingPath: [any CodingKey]) {
+		self.writer = writer
+		self.depth = depth
+		self.codingPath = codingPath
+	}
+
+	func container<Key: CodingKey>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> {
+		KeyedEncodingContainer(JSONKeyedEncodingContainer<Key>(encoder: self, frameID: openFrame(isObject: true)))
+	}
+
+	func unkeyedContainer() -> any UnkeyedEncodingContainer {
+		JSONUnkeyedEncodingContainer(encoder: self, frameID: openFrame(isObject: false))
+	}
+
+	func singleValueContainer() -> any SingleValueEncodingContainer {
+		JSONSingleValueEncodingContainer(encoder: self)
+	}
+
+	/// Opens the container of this value, or returns the already open one so repeated requests share it.
+	private func openFrame(isObject: Bool) -> Int {
+		if let frameID, let index = writer.frameIndex(of: frameID), writer.frames[index].isObject == isObject {
+			return frameID
+		}
+		prepareSlot()
+		let id = writer.openFrame(isObject: isObject)
+		frameID = id
+		return id
+	}
+
+	/// Closes containers of previous siblings before a value is written into this encoder's slot.
+	func prepareSlot() {
+		guard writer.frames.count >= depth else {
+			writer.error =
+				writer.error
+				?? EncodingError.invalidValue(
+					"",
+					EncodingError.Context(
+						codingPath: codingPath,
+						debugDescription: "Value was encoded after its parent container had been closed."
+					)
+				)
+			return
+		}
+		writer.closeFrames(downTo: depth)
+	}
+}
+
+struct JSONKeyedEncodingContainer<Key: CodingKey>: KeyedEncodingContainerProtocol {
+	let encoder: JSONStreamEncoderImpl
+	let frameID: Int
+	var codingPath: [any CodingKey] { encoder.codingPath }
+
+	private var writer: JSONWriter { encoder.writer }
+
+	init(encoder: JSONStreamEncoderImpl, frameID: Int) {
+		self.encoder = encoder
+		self.frameID = frameID
+	}
+
+	@inline(__always)
+	private func begin(_ key: Key) throws {
+		try writer.beginEntry(in: frameID, key: key.stringValue, codingPath: codingPath + [key])
+	}
+
+	mutating func encodeNil(forKey key: Key) throws {
+		try begin(key)
+		writer.writeNull()
+	}
+
+	mutating func encode(_ value: Bool, forKey key: Key) throws {
+		try begin(key)
+		writer.writeBool(value)
+	}
+
+	mutating func encode(_ value: String, forKey key: Key) throws {
+		try begin(key)
+		writer.writeString(value)
+	}
+
+	mutating func encode(_ value: Double, forKey key: Key) throws {
+		try begin(key)
+		try writer.writeFloatingPoint(value, codingPath: codingPath + [key])
+	}
+
+	mutating func encode(_ value: Float, forKey key: Key) throws {
+		try begin(key)
+		try writer.writeFloatingPoint(value, codingPath: codingPath + [key])
+	}
+
+	mutating func encode(_ value: Int, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int8, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int16, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int32, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int64, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt8, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt16, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt32, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt64, forKey key: Key) throws {
+		try begin(key)
+		writer.writeInteger(value)
+	}
+
+	mutating func encode<T: Encodable>(_ value: T, forKey key: Key) throws {
+		try begin(key)
+		try writer.writeValue(value, codingPath: codingPath + [key])
+	}
+
+	mutating func nestedContainer<NestedKey: CodingKey>(
+		keyedBy keyType: NestedKey.Type,
+		forKey key: Key
+	) -> KeyedEncodingContainer<NestedKey> {
+		writer.beginEntryDeferred(in: frameID, key: key.stringValue, codingPath: codingPath + [key])
+		return nestedEncoder(for: key).container(keyedBy: keyType)
+	}
+
+	mutating func nestedUnkeyedContainer(forKey key: Key) -> any UnkeyedEncodingContainer {
+		writer.beginEntryDeferred(in: frameID, key: key.stringValue, codingPath: codingPath + [key])
+		return nestedEncoder(for: key).unkeyedContainer()
+	}
+
+	mutating func superEncoder() -> any Encoder {
+		let key = JSONCodingKey(stringValue: "super")
+		writer.beginEntryDeferred(in: frameID, key: key.stringValue, codingPath: codingPath + [key])
+		return nestedEncoder(for: key)
+	}
+
+	mutating func superEncoder(forKey key: Key) -> any Encoder {
+		writer.beginEntryDeferred(in: frameID, key: key.stringValue, codingPath: codingPath + [key])
+		return nestedEncoder(for: key)
+	}
+
+	private func nestedEncoder(for key: any CodingKey) -> JSONStreamEncoderImpl {
+		JSONStreamEncoderImpl(writer: writer, depth: writer.frames.count, codingPath: codingPath + [key])
+	}
+}
+
+struct JSONUnkeyedEncodingContainer: UnkeyedEncodingContainer {
+	let encoder: JSONStreamEncoderImpl
+	let frameID: Int
+	private(set) var count = 0
+	var codingPath: [any CodingKey] { encoder.codingPath }
+
+	private var writer: JSONWriter { encoder.writer }
+
+	init(encoder: JSONStreamEncoderImpl, frameID: Int) {
+		self.encoder = encoder
+		self.frameID = frameID
+	}
+
+	@inline(__always)
+	private mutating func begin() throws -> [any CodingKey] {
+		let path = codingPath + [JSONCodingKey(intValue: count)]
+		try writer.beginEntry(in: frameID, key: nil, codingPath: path)
+		count += 1
+		return path
+	}
+
+	mutating func encodeNil() throws {
+		_ = try begin()
+		writer.writeNull()
+	}
+
+	mutating func encode(_ value: Bool) throws {
+		_ = try begin()
+		writer.writeBool(value)
+	}
+
+	mutating func encode(_ value: String) throws {
+		_ = try begin()
+		writer.writeString(value)
+	}
+
+	mutating func encode(_ value: Double) throws {
+		let path = try begin()
+		try writer.writeFloatingPoint(value, codingPath: path)
+	}
+
+	mutating func encode(_ value: Float) throws {
+		let path = try begin()
+		try writer.writeFloatingPoint(value, codingPath: path)
+	}
+
+	mutating func encode(_ value: Int) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int8) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int16) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int32) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int64) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt8) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt16) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt32) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt64) throws {
+		_ = try begin()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode<T: Encodable>(_ value: T) throws {
+		let path = try begin()
+		try writer.writeValue(value, codingPath: path)
+	}
+
+	mutating func nestedContainer<NestedKey: CodingKey>(keyedBy keyType: NestedKey.Type) -> KeyedEncodingContainer<NestedKey> {
+		nestedEncoder().container(keyedBy: keyType)
+	}
+
+	mutating func nestedUnkeyedContainer() -> any UnkeyedEncodingContainer {
+		nestedEncoder().unkeyedContainer()
+	}
+
+	mutating func superEncoder() -> any Encoder {
+		nestedEncoder()
+	}
+
+	private mutating func nestedEncoder() -> JSONStreamEncoderImpl {
+		let path = codingPath + [JSONCodingKey(intValue: count)]
+		writer.beginEntryDeferred(in: frameID, key: nil, codingPath: path)
+		count += 1
+		return JSONStreamEncoderImpl(writer: writer, depth: writer.frames.count, codingPath: path)
+	}
+}
+
+struct JSONSingleValueEncodingContainer: SingleValueEncodingContainer {
+	let encoder: JSONStreamEncoderImpl
+	var codingPath: [any CodingKey] { encoder.codingPath }
+
+	private var writer: JSONWriter { encoder.writer }
+
+	mutating func encodeNil() throws {
+		encoder.prepareSlot()
+		writer.writeNull()
+	}
+
+	mutating func encode(_ value: Bool) throws {
+		encoder.prepareSlot()
+		writer.writeBool(value)
+	}
+
+	mutating func encode(_ value: String) throws {
+		encoder.prepareSlot()
+		writer.writeString(value)
+	}
+
+	mutating func encode(_ value: Double) throws {
+		encoder.prepareSlot()
+		try writer.writeFloatingPoint(value, codingPath: codingPath)
+	}
+
+	mutating func encode(_ value: Float) throws {
+		encoder.prepareSlot()
+		try writer.writeFloatingPoint(value, codingPath: codingPath)
+	}
+
+	mutating func encode(_ value: Int) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int8) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int16) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int32) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: Int64) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt8) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt16) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt32) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode(_ value: UInt64) throws {
+		encoder.prepareSlot()
+		writer.writeInteger(value)
+	}
+
+	mutating func encode<T: Encodable>(_ value: T) throws {
+		encoder.prepareSlot()
+		try writer.writeValue(value, codingPath: codingPath)
+	}
+}
+
+struct JSONCodingKey: CodingKey {
+	let stringValue: String
+	let intValue: Int?
+
+	init(stringValue: String) {
+		self.stringValue = stringValue
+		self.intValue = nil
+	}
+
+	init(intValue: Int) {
+		self.stringValue = "\(intValue)"
+		self.intValue = intValue
+	}
+}
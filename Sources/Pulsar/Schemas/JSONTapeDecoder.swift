@@ -0,0 +1,957 @@
+import Foundation
+
+/// Decodes `Decodable` values from JSON without copying the input.
+///
+/// A single pass over the borrowed bytes validates the document and records every value in a flat token tape, which
+/// the `Decoder` then walks. Strings and numbers are only materialized when they are decoded.
+///
+/// Dates are decoded from milliseconds since epoch and `Data` from base64, matching the Jackson defaults of the Java
+/// client.
+enum JSONTapeDecoder {
+	static func decode<T: Decodable>(_ type: T.Type, from data: Data) throws -> T {
+		try data.withUnsafeBytes { bytes in
+			var parser = JSONParser(bytes: bytes)
+			let document = JSONDocument(bytes: bytes, tokens: try parser.parse())
+			// The document borrows `bytes`, so decoding has to complete within this closure.
+			return try document.decode(T.self, at: 0, codingPath: [])
+		}
+	}
+}
+
+// MARK: - Parser
+
+struct JSONToken {
+	enum Kind: UInt8 {
+		case object
+		case array
+		case string
+		case escapedString
+		case integer
+		case float
+		case `true`
+		case `false`
+		case null
+	}
+
+	var kind: Kind
+	/// Byte range of the value, without the quotes for strings.
+	var start: Int
+	var end: Int
+	/// The index of the token following this value and all of its children.
+	var next: Int
+	/// The number of elements of an array, or members of an object.
+	var count: Int
+}
+
+struct JSONParser {
+	static let maxDepth = 512
+
+	let bytes: UnsafeRawBufferPointer
+	private var offset = 0
+	private var tokens: [JSONToken] = []
+
+	init(bytes: UnsafeRawBufferPointer) {
+		self.bytes = bytes
+		tokens.reserveCapacity(bytes.count / 8)
+	}
+
+	mutating func parse() throws -> [JSONToken] {
+		skipWhitespace()
+		try parseValue(depth: 0)
+		skipWhitespace()
+		guard offset == bytes.count else {
+			throw corrupted("Unexpected data after the top-level value")
+		}
+		return tokens
+	}
+
+	private mutating func parseValue(depth: Int) throws {
+		guard offset < bytes.count else {
+			throw corrupted("Unexpected end of data")
+		}
+		switch bytes[offset] {
+			case UInt8(ascii: "{"): try parseObject(depth: depth)
+			case UInt8(ascii: "["): try parseArray(depth: depth)
+			case UInt8(ascii: "\""): try parseString()
+			case UInt8(ascii: "t"): try parseLiteral("true", kind: .true)
+			case UInt8(ascii: "f"): try parseLiteral("false", kind: .false)
+			case UInt8(ascii: "n"): try parseLiteral("null", kind: .null)
+			case UInt8(ascii: "-"), UInt8(ascii: "0") ... UInt8(ascii: "9"): try parseNumber()
+			default: throw corrupted("Unexpected character")
+		}
+	}
+
+	private mutating func parseObject(depth: Int) throws {
+		guard depth < Self.maxDepth else {
+			throw corrupted("Too many nested containers")
+		}
+		let index = appendToken(.object, start: offset, end: offset)
+		offset += 1
+		skipWhitespace()
+		var count = 0
+		if !consume(UInt8(ascii: "}")) {
+			repeat {
+				skipWhitespace()
+				guard offset < bytes.count, bytes[offset] == UInt8(ascii: "\"") else {
+					throw corrupted("Expected object key")
+				}
+				try parseString()
+				skipWhitespace()
+				guard consume(UInt8(ascii: ":")) else {
+					throw corrupted("Expected ':' after object key")
+				}
+				skipWhitespace()
+				try parseValue(depth: depth + 1)
+				skipWhitespace()
+				count += 1
+			} while consume(UInt8(ascii: ","))
+			guard consume(UInt8(ascii: "}")) else {
+				throw corrupted("Expected ',' or '}' in object")
+			}
+		}
+		finishContainer(index, count: count)
+	}
+
+	private mutating func parseArray(depth: Int) throws {
+		guard depth < Self.maxDepth else {
+			throw corrupted("Too many nested containers")
+		}
+		let index = appendToken(.array, start: offset, end: offset)
+		offset += 1
+		skipWhitespace()
+		var count = 0
+		if !consume(UInt8(ascii: "]")) {
+			repeat {
+				skipWhitespace()
+				try parseValue(depth: depth + 1)
+				skipWhitespace()
+				count += 1
+			} while consume(UInt8(ascii: ","))
+			guard consume(UInt8(ascii: "]")) else {
+				throw corrupted("Expected ',' or ']' in array")
+			}
+		}
+		finishContainer(index, count: count)
+	}
+
+	private mutating func parseString() throws {
+		offset += 1
+		let start = offset
+		var escaped = false
+		while offset < bytes.count {
+			let byte = bytes[offset]
+			switch byte {
+				case UInt8(ascii: "\""):
+					appendToken(escaped ? .escapedString : .string, start: start, end: offset)
+					offset += 1
+					return
+				case UInt8(ascii: "\\"):
+					escaped = true
+					offset += 1
+					guard offset < bytes.count else { break }
+					switch bytes[offset] {
+						case UInt8(ascii: "\""), UInt8(ascii: "\\"), UInt8(ascii: "/"), UInt8(ascii: "b"), UInt8(ascii: "f"),
+							UInt8(ascii: "n"), UInt8(ascii: "r"), UInt8(ascii: "t"):
+							offset += 1
+						case UInt8(ascii: "u"):
+							guard offset + 4 < bytes.count, (1 ... 4).allSatisfy({ hexValue(bytes[offset + $0]) != nil }) else {
+								throw corrupted("Invalid unicode escape")
+							}
+							offset += 5
+						default:
+							throw corrupted("Invalid escape sequence")
+					}
+				case 0 ..< 0x20:
+					throw corrupted("Unescaped control character in string")
+				default:
+					offset += 1
+			}
+		}
+		throw corrupted("Unterminated string")
+	}
+
+	private mutating func parseNumber() throws {
+		let start = offset
+		var isInteger = true
+		_ = consume(UInt8(ascii: "-"))
+		if consume(UInt8(ascii: "0")) {
+			// No leading zeros.
+		} else if consumeDigits() == 0 {
+			throw corrupted("Invalid number")
+		}
+		if consume(UInt8(ascii: ".")) {
+			isInteger = false
+			guard consumeDigits() > 0 else {
+				throw corrupted("Expected digits after decimal point")
+			}
+		}
+		if offset < bytes.count, bytes[offset] | 0x20 == UInt8(ascii: "e") {
+			offset += 1
+			isInteger = false
+			if offset < bytes.count, bytes[offset] == UInt8(ascii: "+") || bytes[offset] == UInt8(ascii: "-") {
+				offset += 1
+			}
+			guard consumeDigits() > 0 else {
+				throw corrupted("Expected digits in exponent")
+			}
+		}
+		appendToken(isInteger ? .integer : .float, start: start, end: offset)
+	}
+
+	private mutating func parseLiteral(_ literal: StaticString, kind: JSONToken.Kind) throws {
+		let length = literal.utf8CodeUnitCount
+		guard offset + length <= bytes.count,
+			memcmp(bytes.baseAddress! + offset, literal.utf8Start, length) == 0
+		else {
+			throw corrupted("Invalid literal")
+		}
+		appendToken(kind, start: offset, end: offset + length)
+		offset += length
+	}
+
+	private mutating func consumeDigits() -> Int {
+		let start = offset
+		while offset < bytes.count, bytes[offset] >= UInt8(ascii: "0"), bytes[offset] <= UInt8(ascii: "9") {
+			offset += 1
+		}
+		return offset - start
+	}
+
+	@inline(__always)
+	private mutating func consume(_ byte: UInt8) -> Bool {
+		guard offset < bytes.count, bytes[offset] == byte else { return false }
+		offset += 1
+		return true
+	}
+
+	@inline(__always)
+	private mutating func skipWhitespace() {
+		while offset < bytes.count {
+			switch bytes[offset] {
+				case UInt8(ascii: " "), UInt8(ascii: "\n"), UInt8(ascii: "\r"), UInt8(ascii: "\t"): offset += 1
+				default: return
+			}
+		}
+	}
+
+	@discardableResult
+	private mutating func appendToken(_ kind: JSONToken.Kind, start: Int, end: Int) -> Int {
+		tokens.append(JSONToken(kind: kind, start: start, end: end, next: tokens.count + 1, count: 0))
+		return tokens.count - 1
+	}
+
+	private mutating func finishContainer(_ index: Int, count: Int) {
+		tokens[index].end = offset
+		tokens[index].next = tokens.count
+		tokens[index].count = count
+	}
+
+	private func corrupted(_ description: String) -> DecodingError {
+		.dataCorrupted(
+			DecodingError.Context(codingPath: [], debugDescription: "Invalid JSON: \(description) at offset \(offset).")
+		)
+	}
+}
+
+@inline(__always)
+private func hexValue(_ byte: UInt8) -> UInt8? {
+	switch byte {
+		case UInt8(ascii: "0") ... UInt8(ascii: "9"): return byte - UInt8(ascii: "0")
+		case UInt8(ascii: "a") ... UInt8(ascii: "f"): return byte - UInt8(ascii: "a") + 10
+		case UInt8(ascii: "A") ... UInt8(ascii: "F"): return byte - UInt8(ascii: "A") + 10
+		default: return nil
+	}
+}
+
+// MARK: - Document
+
+/// A parsed JSON document borrowing the bytes it was parsed from.
+final class JSONDocument {
+	let bytes: UnsafeRawBufferPointer
+	let tokens: [JSONToken]
+
+	init(bytes: UnsafeRawBufferPointer, tokens: [JSONToken]) {
+		self.bytes = bytes
+		self.tokens = tokens
+	}
+
+	func decode<T: Decodable>(_ type: T.Type, at index: Int, codingPath: [any CodingKey]) throws -> T {
+		if T.self == String.self {
+			return try string(at: index, codingPath: codingPath) as! T
+		} else if T.self == Int.self {
+			return try integer(Int.self, at: index, codingPath: codingPath) as! T
+		} else if T.self == Double.self {
+			return try floatingPoint(Double.self, at: index, codingPath: codingPath) as! T
+		} else if T.self == Bool.self {
+			return try bool(at: index, codingPath: codingPath) as! T
+		} else if T.self == Date.self {
+			let milliseconds = try floatingPoint(Double.self, at: index, codingPath: codingPath)
+			return Date(timeIntervalSince1970: milliseconds / 1_000) as! T
+		} else if T.self == Data.self {
+			guard let data = Data(base64Encoded: try string(at: index, codingPath: codingPath)) else {
+				throw DecodingError.dataCorrupted(
+					DecodingError.Context(codingPath: codingPath, debugDescription: "Encountered Data is not valid Base64.")
+				)
+			}
+			return data as! T
+		} else if T.self == URL.self {
+			guard let url = URL(string: try string(at: index, codingPath: codingPath)) else {
+				throw DecodingError.dataCorrupted(
+					DecodingError.Context(codingPath: codingPath, debugDescription: "Invalid URL string.")
+				)
+			}
+			return url as! T
+		} else if T.self == Decimal.self {
+			try expect([.integer, .float], at: index, type: Decimal.self, codingPath: codingPath)
+			guard let decimal = Decimal(string: rawString(at: index)) else {
+				throw mismatch(Decimal.self, at: index, codingPath: codingPath)
+			}
+			return decimal as! T
+		}
+		return try T(from: JSONTapeDecoderImpl(document: self, index: index, codingPath: codingPath))
+	}
+
+	// MARK: Primitives
+
+	@inline(__always)
+	func isNull(at index: Int) -> Bool {
+		tokens[index].kind == .null
+	}
+
+	func bool(at index: Int, codingPath: [any CodingKey]) throws -> Bool {
+		switch tokens[index].kind {
+			case .true: return true
+			case .false: return false
+			default: throw mismatch(Bool.self, at: index, codingPath: codingPath)
+		}
+	}
+
+	func string(at index: Int, codingPath: [any CodingKey]) throws -> String {
+		let token = tokens[index]
+		switch token.kind {
+			case .string:
+				let utf8 = UnsafeRawBufferPointer(rebasing: bytes[token.start ..< token.end])
+				guard let string = String(validating: utf8, as: UTF8.self) else {
+					throw DecodingError.dataCorrupted(
+						DecodingError.Context(codingPath: codingPath, debugDescription: "String is not valid UTF-8.")
+					)
+				}
+				return string
+			case .escapedString:
+				guard let string = String(validating: unescape(token), as: UTF8.self) else {
+					throw DecodingError.dataCorrupted(
+						DecodingError.Context(codingPath: codingPath, debugDescription: "String is not valid UTF-8.")
+					)
+				}
+				return string
+			default:
+				throw mismatch(String.self, at: index, codingPath: codingPath)
+		}
+	}
+
+	func integer<I: FixedWidthInteger>(_ type: I.Type, at index: Int, codingPath: [any CodingKey]) throws -> I {
+		let token = tokens[index]
+		switch token.kind {
+			case .integer:
+				var offset = token.start
+				let negative = bytes[offset] == UInt8(ascii: "-")
+				if negative {
+					offset += 1
+				}
+				var value: I = 0
+				while offset < token.end {
+					let digit = I(bytes[offset] &- UInt8(ascii: "0"))
+					let (multiplied, overflow) = value.multipliedReportingOverflow(by: 10)
+					let (added, addOverflow) =
+						negative ? multiplied.subtractingReportingOverflow(digit) : multiplied.addingReportingOverflow(digit)
+					guard !overflow, !addOverflow else {
+						throw fitError(I.self, at: index, codingPath: codingPath)
+					}
+					value = added
+					offset += 1
+				}
+				return value
+			case .float:
+				// Accept numbers like `1.0` or `1e3` that are exactly representable.
+				guard let double = Double(rawString(at: index)), let value = I(exactly: double) else {
+					throw fitError(I.self, at: index, codingPath: codingPath)
+				}
+				return value
+			default:
+				throw mismatch(I.self, at: index, codingPath: codingPath)
+		}
+	}
+
+	func floatingPoint<F: BinaryFloatingPoint & LosslessStringConvertible>(
+		_ type: F.Type,
+		at index: Int,
+		codingPath: [any CodingKey]
+	) throws -> F {
+		let token = tokens[index]
+		switch token.kind {
+			case .integer where token.end - token.start <= 15:
+				// Up to 15 digits are exactly representable, skip string conversion.
+				return F(try integer(Int64.self, at: index, codingPath: codingPath))
+			case .integer, .float:
+				guard let value = F(rawString(at: index)), value.isFinite else {
+					throw fitError(F.self, at: index, codingPath: codingPath)
+				}
+				return value
+			default:
+				throw mismatch(F.self, at: index, codingPath: codingPath)
+		}
+	}
+
+	// MARK: Object lookup
+
+	/// Returns whether the string token at `index` equals `key`.
+	@inline(__always)
+	func keyMatches(_ index: Int, _ key: inout String) -> Bool {
+		let token = tokens[index]
+		if token.kind == .escapedString {
+			return unescape(token).elementsEqual(key.utf8)
+		}
+		return key.withUTF8 { utf8 in
+			utf8.count == token.end - token.start
+				&& (utf8.count == 0 || memcmp(utf8.baseAddress!, bytes.baseAddress! + token.start, utf8.count) == 0)
+		}
+	}
+
+	// MARK: Helpers
+
+	func rawString(at index: Int) -> String {
+		let token = tokens[index]
+		return String(decoding: UnsafeRawBufferPointer(rebasing: bytes[token.start ..< token.end]), as: UTF8.self)
+	}
+
+	private func unescape(_ token: JSONToken) -> [UInt8] {
+		var result: [UInt8] = []
+		result.reserveCapacity(token.end - token.start)
+		var offset = token.start
+		while offset < token.end {
+			let byte = bytes[offset]
+			guard byte == UInt8(ascii: "\\") else {
+				result.append(byte)
+				offset += 1
+				continue
+			}
+			let escape = bytes[offset + 1]
+			offset += 2
+			switch escape {
+				case UInt8(ascii: "b"): result.append(0x08)
+				case UInt8(ascii: "f"): result.append(0x0C)
+				case UInt8(ascii: "n"): result.append(UInt8(ascii: "\n"))
+				case UInt8(ascii: "r"): result.append(UInt8(ascii: "\r"))
+				case UInt8(ascii: "t"): result.append(UInt8(ascii: "\t"))
+				case UInt8(ascii: "u"):
+					var scalar = readHex4(at: offset)
+					offset += 4
+					// Combine surrogate pairs, lone surrogates become U+FFFD.
+					if (0xD800 ..< 0xDC00).contains(scalar), offset + 6 <= token.end, bytes[offset] == UInt8(ascii: "\\"),
+						bytes[offset + 1] == UInt8(ascii: "u")
+					{
+						let low = readHex4(at: offset + 2)
+						if (0xDC00 ..< 0xE000).contains(low) {
+							scalar = 0x10000 + ((scalar - 0xD800) << 10) + (low - 0xDC00)
+							offset += 6
+						}
+					}
+					result.append(contentsOf: UTF8.encode(Unicode.Scalar(scalar) ?? "\u{FFFD}")!)
+				default: result.append(escape)
+			}
+		}
+		return result
+	}
+
+	private func readHex4(at offset: Int) -> UInt32 {
+		(0 ..< 4).reduce(0) { value, i in value << 4 | UInt32(hexValue(bytes[offset + i]) ?? 0) }
+	}
+
+	func expect(_ kinds: [JSONToken.Kind], at index: Int, type: Any.Type, codingPath: [any CodingKey]) throws {
+		guard kinds.contains(tokens[index].kind) else {
+			throw mismatch(type, at: index, codingPath: codingPath)
+		}
+	}
+
+	func mismatch(_ type: Any.Type, at index: Int, codingPath: [any CodingKey]) -> DecodingError {
+		if tokens[index].kind == .null {
+			return .valueNotFound(
+				type,
+				DecodingError.Context(codingPath: codingPath, debugDescription: "Expected \(type) value but found null instead.")
+			)
+		}
+		return .typeMismatch(
+			type,
+			DecodingError.Context(
+				codingPath: codingPath,
+				debugDescription: "Expected to decode \(type) but found \(tokens[index].kind) instead."
+			)
+		)
+	}
+
+	private func fitError(_ type: Any.Type, at index: Int, codingPath: [any CodingKey]) -> DecodingError {
+		.dataCorrupted(
+			DecodingError.Context(
+				codingPath: codingPath,
+				debugDescription: "Parsed JSON number <\(rawString(at: index))> does not fit in \(type)."
+			)
+		)
+	}
+}
+
+// MARK: - Decoder
+
+final class JSONTapeDecoderImpl: Decoder {
+	let document: JSONDocument
+	let index: Int
+	let codingPath: [any CodingKey]
+	var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+	init(document: JSONDocument, index: Int, codingPath: [any CodingKey]) {
+		self.document = document
+		self.index = index
+		self.codingPath = codingPath
+	}
+
+	func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+		try document.expect([.object], at: index, type: [String: Any].self, codingPath: codingPath)
+		return KeyedDecodingContainer(JSONKeyedDecodingContainer<Key>(decoder: self))
+	}
+
+	func unkeyedContainer() throws -> any UnkeyedDecodingContainer {
+		try document.expect([.array], at: index, type: [Any].self, codingPath: codingPath)
+		return JSONUnkeyedDecodingContainer(decoder: self)
+	}
+
+	func singleValueContainer() throws -> any SingleValueDecodingContainer {
+		JSONSingleValueDecodingContainer(decoder: self)
+	}
+}
+
+struct JSONKeyedDecodingContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+	let decoder: JSONTapeDecoderImpl
+	private let cursor: Cursor
+	var codingPath: [any CodingKey] { decoder.codingPath }
+
+	private var document: JSONDocument { decoder.document }
+
+	/// The key token where the next lookup starts, synthesized decoders usually request keys in document order.
+	private final class Cursor {
+		var keyIndex: Int
+		init(_ keyIndex: Int) { self.keyIndex = keyIndex }
+	}
+
+	init(decoder: JSONTapeDecoderImpl) {
+		self.decoder = decoder
+		self.cursor = Cursor(decoder.index + 1)
+	}
+
+	var allKeys: [Key] {
+		var keys: [Key] = []
+		var keyIndex = decoder.index + 1
+		for _ in 0 ..< document.tokens[decoder.index].count {
+			if let string = try? document.string(at: keyIndex, codingPath: codingPath), let key = Key(stringValue: string) {
+				keys.append(key)
+			}
+			keyIndex = document.tokens[keyIndex + 1].next
+		}
+		return keys
+	}
+
+	/// Returns the index of the value token for `key`.
+	private func valueIndex(for key: Key) -> Int? {
+		let object = document.tokens[decoder.index]
+		guard object.count > 0 else { return nil }
+		var name = key.stringValue
+		let first = decoder.index + 1
+		var keyIndex = cursor.keyIndex
+		for _ in 0 ..< object.count {
+			if document.keyMatches(keyIndex, &name) {
+				cursor.keyIndex = keyIndex
+				return keyIndex + 1
+			}
+			keyIndex = document.tokens[keyIndex + 1].next
+			if keyIndex == object.next {
+				keyIndex = first
+			}
+		}
+		return nil
+	}
+
+	private func requireValue(for key: Key) throws -> Int {
+		guard let index = valueIndex(for: key) else {
+			throw DecodingError.keyNotFound(
+				key,
+				DecodingError.Context(codingPath: codingPath, debugDescription: "No value associated with key \(key.stringValue).")
+			)
+		}
+		return index
+	}
+
+	func contains(_ key: Key) -> Bool {
+		valueIndex(for: key) != nil
+	}
+
+	func decodeNil(forKey key: Key) throws -> Bool {
+		document.isNull(at: try requireValue(for: key))
+	}
+
+	func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool {
+		try document.bool(at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: String.Type, forKey key: Key) throws -> String {
+		try document.string(at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: Double.Type, forKey key: Key) throws -> Double {
+		try document.floatingPoint(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: Float.Type, forKey key: Key) throws -> Float {
+		try document.floatingPoint(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: Int.Type, forKey key: Key) throws -> Int {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 {
+		try document.integer(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+		try document.decode(type, at: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+
+	func decodeIfPresent<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Bool.Type, forKey key: Key) throws -> Bool? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: String.Type, forKey key: Key) throws -> String? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Double.Type, forKey key: Key) throws -> Double? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Float.Type, forKey key: Key) throws -> Float? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int.Type, forKey key: Key) throws -> Int? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int8.Type, forKey key: Key) throws -> Int8? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int16.Type, forKey key: Key) throws -> Int16? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int32.Type, forKey key: Key) throws -> Int32? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: Int64.Type, forKey key: Key) throws -> Int64? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt.Type, forKey key: Key) throws -> UInt? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt8.Type, forKey key: Key) throws -> UInt8? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt16.Type, forKey key: Key) throws -> UInt16? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt32.Type, forKey key: Key) throws -> UInt32? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	func decodeIfPresent(_ type: UInt64.Type, forKey key: Key) throws -> UInt64? {
+		try decodeIfPresent(type, at: valueIndex(for: key), forKey: key)
+	}
+
+	/// A single lookup instead of the default `contains`, `decodeNil` and `decode`.
+	private func decodeIfPresent<T: Decodable>(_ type: T.Type, at index: Int?, forKey key: Key) throws -> T? {
+		guard let index, !document.isNull(at: index) else { return nil }
+		return try document.decode(type, at: index, codingPath: codingPath + [key])
+	}
+
+	func nestedContainer<NestedKey: CodingKey>(
+		keyedBy type: NestedKey.Type,
+		forKey key: Key
+	) throws -> KeyedDecodingContainer<NestedKey> {
+		try JSONTapeDecoderImpl(document: document, index: try requireValue(for: key), codingPath: codingPath + [key])
+			.container(keyedBy: type)
+	}
+
+	func nestedUnkeyedContainer(forKey key: Key) throws -> any UnkeyedDecodingContainer {
+		try JSONTapeDecoderImpl(document: document, index: try requireValue(for: key), codingPath: codingPath + [key])
+			.unkeyedContainer()
+	}
+
+	func superDecoder() throws -> any Decoder {
+		let key = JSONCodingKey(stringValue: "super")
+		var name = key.stringValue
+		var keyIndex = decoder.index + 1
+		for _ in 0 ..< document.tokens[decoder.index].count {
+			if document.keyMatches(keyIndex, &name) {
+				return JSONTapeDecoderImpl(document: document, index: keyIndex + 1, codingPath: codingPath + [key])
+			}
+			keyIndex = document.tokens[keyIndex + 1].next
+		}
+		throw DecodingError.keyNotFound(
+			key,
+			DecodingError.Context(codingPath: codingPath, debugDescription: "No value associated with key super.")
+		)
+	}
+
+	func superDecoder(forKey key: Key) throws -> any Decoder {
+		JSONTapeDecoderImpl(document: document, index: try requireValue(for: key), codingPath: codingPath + [key])
+	}
+}
+
+struct JSONUnkeyedDecodingContainer: UnkeyedDecodingContainer {
+	let decoder: JSONTapeDecoderImpl
+	let count: Int?
+	private(set) var currentIndex = 0
+	private var tokenIndex: Int
+	var codingPath: [any CodingKey] { decoder.codingPath }
+	var isAtEnd: Bool { currentIndex >= count! }
+
+	private var document: JSONDocument { decoder.document }
+
+	init(decoder: JSONTapeDecoderImpl) {
+		self.decoder = decoder
+		self.count = decoder.document.tokens[decoder.index].count
+		self.tokenIndex = decoder.index + 1
+	}
+
+	/// Returns the current element and advances past it.
+	private mutating func next<T>(_ type: T.Type) throws -> (index: Int, codingPath: [any CodingKey]) {
+		let path = codingPath + [JSONCodingKey(intValue: currentIndex)]
+		guard !isAtEnd else {
+			throw DecodingError.valueNotFound(
+				type,
+				DecodingError.Context(codingPath: path, debugDescription: "Unkeyed container is at end.")
+			)
+		}
+		let index = tokenIndex
+		tokenIndex = document.tokens[index].next
+		currentIndex += 1
+		return (index, path)
+	}
+
+	mutating func decodeNil() throws -> Bool {
+		guard !isAtEnd, document.isNull(at: tokenIndex) else { return false }
+		_ = try next(Never.self)
+		return true
+	}
+
+	mutating func decode(_ type: Bool.Type) throws -> Bool {
+		let (index, path) = try next(type)
+		return try document.bool(at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: String.Type) throws -> String {
+		let (index, path) = try next(type)
+		return try document.string(at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: Double.Type) throws -> Double {
+		let (index, path) = try next(type)
+		return try document.floatingPoint(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: Float.Type) throws -> Float {
+		let (index, path) = try next(type)
+		return try document.floatingPoint(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: Int.Type) throws -> Int {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: Int8.Type) throws -> Int8 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: Int16.Type) throws -> Int16 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: Int32.Type) throws -> Int32 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: Int64.Type) throws -> Int64 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: UInt.Type) throws -> UInt {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: UInt8.Type) throws -> UInt8 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: UInt16.Type) throws -> UInt16 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: UInt32.Type) throws -> UInt32 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode(_ type: UInt64.Type) throws -> UInt64 {
+		let (index, path) = try next(type)
+		return try document.integer(type, at: index, codingPath: path)
+	}
+
+	mutating func decode<T: Decodable>(_ type: T.Type) throws -> T {
+		let (index, path) = try next(type)
+		return try document.decode(type, at: index, codingPath: path)
+	}
+
+	mutating func nestedContainer<NestedKey: CodingKey>(keyedBy type: NestedKey.Type) throws -> KeyedDecodingContainer<NestedKey> {
+		let (index, path) = try next([String: Any].self)
+		return try JSONTapeDecoderImpl(document: document, index: index, codingPath: path).container(keyedBy: type)
+	}
+
+	mutating func nestedUnkeyedContainer() throws -> any UnkeyedDecodingContainer {
+		let (index, path) = try next([Any].self)
+		return try JSONTapeDecoderImpl(document: document, index: index, codingPath: path).unkeyedContainer()
+	}
+
+	mutating func superDecoder() throws -> any Decoder {
+		let (index, path) = try next(Any.self)
+		return JSONTapeDecoderImpl(document: document, index: index, codingPath: path)
+	}
+}
+
+struct JSONSingleValueDecodingContainer: SingleValueDecodingContainer {
+	let decoder: JSONTapeDecoderImpl
+	var codingPath: [any CodingKey] { decoder.codingPath }
+
+	private var document: JSONDocument { decoder.document }
+	private var index: Int { decoder.index }
+
+	func decodeNil() -> Bool {
+		document.isNull(at: index)
+	}
+
+	func decode(_ type: Bool.Type) throws -> Bool {
+		try document.bool(at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: String.Type) throws -> String {
+		try document.string(at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: Double.Type) throws -> Double {
+		try document.floatingPoint(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: Float.Type) throws -> Float {
+		try document.floatingPoint(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: Int.Type) throws -> Int {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: Int8.Type) throws -> Int8 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: Int16.Type) throws -> Int16 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: Int32.Type) throws -> Int32 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: Int64.Type) throws -> Int64 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: UInt.Type) throws -> UInt {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: UInt8.Type) throws -> UInt8 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: UInt16.Type) throws -> UInt16 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: UInt32.Type) throws -> UInt32 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode(_ type: UInt64.Type) throws -> UInt64 {
+		try document.integer(type, at: index, codingPath: codingPath)
+	}
+
+	func decode<T: Decodable>(_ type: T.Type) throws -> T {
+		try document.decode(type, at: index, codingPath: codingPath)
+	}
+}
@@ -0,0 +1,255 @@
+import Foundation
+
+/// How the key and value of a ``KeyValue`` are laid out in a message.
+@frozen
+public enum KeyValueEncodingType: Int, Sendable, CustomStringConvertible {
+	/// The key is stored as the message key, the payload only contains the value.
+	case separated = 0
+	/// Key and value are both stored in the payload.
+	case inline = 1
+
+	/// The name used in the schema properties.
+	public var description: String {
+		switch self {
+			case .separated: return "SEPARATED"
+			case .inline: return "INLINE"
+		}
+	}
+}
+
+/// A type-level marker selecting the ``KeyValueEncodingType`` of a ``KeyValue``.
+public protocol KeyValueEncoding: Sendable {
+	/// The encoding type.
+	static var type: KeyValueEncodingType { get }
+}
+
+/// Stores key and value together in the payload.
+public enum InlineEncoding: KeyValueEncoding {
+	/// The encoding type.
+	public static var type: KeyValueEncodingType { .inline }
+}
+
+/// Stores the key as the message key and the value as the payload.
+public enum SeparatedEncoding: KeyValueEncoding {
+	/// The encoding type.
+	public static var type: KeyValueEncodingType { .separated }
+}
+
+/// A key/value pair with `INLINE` encoding.
+public typealias InlineKeyValue<Key: PulsarSchema, Value: PulsarSchema> = KeyValue<Key, Value, InlineEncoding>
+/// A key/value pair with `SEPARATED` encoding.
+public typealias SeparatedKeyValue<Key: PulsarSchema, Value: PulsarSchema> = KeyValue<Key, Value, SeparatedEncoding>
+
+/// A key/value pair, interoperable with the `KeyValue` schema of the other Pulsar clients.
+///
+/// The encoding is part of the type, because the schema information and decoding are static:
+///
+/// ```swift
+/// let producer: Producer<SeparatedKeyValue<String, Order>> = try client.producer(for: topic)
+/// try await producer.send(Message(content: SeparatedKeyValue(key: order.id, value: order)))
+/// ```
+///
+/// Received key and value are decoded independently, on access only. Reading ``key`` never decodes the value.
+/// For `SEPARATED` encoding, ``Message/decodeKey()`` reads the key from the message key without touching the payload.
+///
+/// - Note: Like the C++ client, `SEPARATED` messages carry the raw key bytes as the message key.
+/// The Java client base64-encodes keys it produces in `SEPARATED` mode, which the C++ client does not expose.
+/// Use `INLINE` encoding for topics shared with Java producers that use binary keys.
+public struct KeyValue<Key: PulsarSchema, Value: PulsarSchema, Encoding: KeyValueEncoding>: PulsarSchema {
+
+	enum Field<T: PulsarSchema>: Sendable {
+		case decoded(T)
+		case encoded(Data, Range<Int>)
+		case null
+
+		var data: Data {
+			get throws {
+				switch self {
+					case .decoded(let value): return try value.encode()
+					case .encoded(let data, let range): return data.subdata(in: range)
+					case .null: throw PulsarError.invalidMessage
+				}
+			}
+		}
+
+		var value: T {
+			get throws {
+				switch self {
+					case .decoded(let value): return value
+					case .encoded(let data, let range): return try T.decode(data.subdata(in: range))
+					case .null: throw PulsarError.invalidMessage
+				}
+			}
+		}
+	}
+
+	let keyField: Field<Key>
+	let valueField: Field<Value>
+
+	/// Creates a new key/value pair.
+	public init(key: Key, value: Value) {
+		self.keyField = .decoded(key)
+		self.valueField = .decoded(value)
+	}
+
+	init(keyField: Field<Key>, valueField: Field<Value>) {
+		self.keyField = keyField
+		self.valueField = valueField
+	}
+
+	/// The key, decoded on access.
+	public var key: Key {
+		get throws { try keyField.value }
+	}
+
+	/// The value, decoded on access.
+	public var value: Value {
+		get throws { try valueField.value }
+	}
+
+	/// The encoded key bytes, without decoding them.
+	public var keyData: Data {
+		get throws { try keyField.data }
+	}
+
+	/// The encoded value bytes, without decoding them.
+	public var valueData: Data {
+		get throws { try valueField.data }
+	}
+
+	/// The schema type for key/value pairs.
+	public var schemaType: PulsarSchemaType {
+		.keyValue
+	}
+
+	/// The schema definition.
+	///
+	/// Key/value schemas are binary and only available through ``schemaInfo``.
+	public var schema: String? {
+		get throws {
+			nil
+		}
+	}
+
+	/// The schema information.
+	public var schemaInfo: SchemaInfo {
+		get throws {
+			try Self.getSchemaInfo()
+		}
+	}
+
+	/// Encodes the key/value pair to data.
+	///
+	/// For `INLINE` encoding this is `[key length][key][value length][value]` with big-endian 32 bit lengths.
+	/// For `SEPARATED` encoding only the value is encoded, the key is set as message key when creating the ``Message``.
+	public func encode() throws -> Data {
+		switch Encoding.type {
+			case .separated:
+				return try valueField.data
+			case .inline:
+				let keyData = try keyField.data
+				let valueData = try valueField.data
+				var data = Data(capacity: 8 + keyData.count + valueData.count)
+				appendLength(keyData.count, to: &data)
+				data.append(keyData)
+				appendLength(valueData.count, to: &data)
+				data.append(valueData)
+				return data
+		}
+	}
+
+	/// Decodes data to a key/value pair.
+	///
+	/// Only the layout is parsed; key and value are decoded when accessed.
+	/// For `SEPARATED` encoding the key is taken from the message key by ``Message/content``.
+	public static func decode(_ data: Data) throws -> Self {
+		try decode(data, messageKey: nil)
+	}
+
+	/// Gets the schema information for the key/value pair.
+	public static func getSchemaInfo() throws -> SchemaInfo {
+		SchemaInfo(
+			keySchema: try Key.getSchemaInfo(),
+			valueSchema: try Value.getSchemaInfo(),
+			encoding: Encoding.type
+		)
+	}
+
+	static func decode(_ data: Data, messageKey: Data?) throws -> Self {
+		// Offsets below assume zero-based indices.
+		let payload = data.startIndex == 0 ? data : Data(data)
+		switch Encoding.type {
+			case .separated:
+				let keyField: Field<Key> = messageKey.map { .encoded($0, 0 ..< $0.count) } ?? .null
+				return Self(keyField: keyField, valueField: .encoded(payload, 0 ..< payload.count))
+			case .inline:
+				var offset = 0
+				let keyField: Field<Key> = try readField(payload, at: &offset)
+				let valueField: Field<Value> = try readField(payload, at: &offset)
+				return Self(keyField: keyField, valueField: valueField)
+		}
+	}
+
+	private static func readField<T: PulsarSchema>(_ data: Data, at offset: inout Int) throws -> Field<T> {
+		guard offset + 4 <= data.count else {
+			throw PulsarError.invalidMessage
+		}
+		let length = Int32(bitPattern: data[offset ..< offset + 4].reduce(UInt32(0)) { ($0 << 8) | UInt32($1) })
+		offset += 4
+		// Other clients write -1 for a null key or value.
+		if length < 0 {
+			return .null
+		}
+		let end = offset + Int(length)
+		guard end <= data.count else {
+			throw PulsarError.invalidMessage
+		}
+		defer { offset = end }
+		return .encoded(data, offset ..< end)
+	}
+}
+
+@inline(__always)
+private func appendLength(_ length: Int, to data: inout Data) {
+	withUnsafeBytes(of: Int32(length).bigEndian) { data.append(contentsOf: $0) }
+}
+
+/// Schemas that move part of their content into the message key.
+protocol MessageKeySchema: PulsarSchema {
+	/// The bytes to set as message key, or `nil` if the content is stored in the payload only.
+	var messageKeyData: Data? { get throws }
+	static var usesMessageKey: Bool { get }
+	static func decode(_ data: Data, messageKey: Data?) throws -> Self
+}
+
+extension KeyValue: MessageKeySchema {
+	var messageKeyData: Data? {
+		get throws {
+			guard Encoding.type == .separated else { return nil }
+			return try keyField.data
+		}
+	}
+
+	static var usesMessageKey: Bool {
+		Encoding.type == .separated
+	}
+}
+
+extension Message {
+	/// Decode only the key of a key/value message.
+	///
+	/// For `SEPARATED` encoding the key is read from the message key, the payload is never copied or decoded.
+	/// - Returns: The decoded key.
+	public func decodeKey<Key, Value, Encoding>() throws -> Key where T == KeyValue<Key, Value, Encoding> {
+		switch Encoding.type {
+			case .separated:
+				let data = withUnsafeKey { bytes in bytes.map { Data($0) } }
+				guard let data else {
+					throw PulsarError.invalidMessage
+				}
+				return try Key.decode(data)
+			case .inline:
+				return try content.key
+		}
+	}
+}
@@ -1,3 +1,4 @@
+import Bridge
 import CxxPulsar
 import CxxStdlib
 import Synchronization
@@ -21,15 +22,39 @@ public final class SchemaInfo: Sendable {
 		self.name = name
 		self.schema = schema
 		self.properties = properties
+		var rawProperties = _Pulsar.StringMap()
+		for (property, value) in properties {
+			Bridge_SI_setProperty(&rawProperties, property, value)
+		}
 		self.state = Mutex(
 			Box(
 				_Pulsar.SchemaInfo(
 					_Pulsar.SchemaType(Int8(schemaType.rawValue)),
 					std.string(name),
 					std.string(schema ?? ""),
-					_Pulsar.StringMap()
+					rawProperties
 				)
 			)
 		)
 	}
+
+	init(keySchema: SchemaInfo, valueSchema: SchemaInfo, encoding: KeyValueEncodingType) {
+		self.schemaType = .keyValue
+		self.name = "KeyValue"
+		self.schema = nil
+		self.properties = [
+			"key.schema.name": keySchema.name,
+			"value.schema.name": valueSchema.name,
+			"kv.encoding.type": encoding.description
+		]
+		// Copy both out of their locks: key and value may be the same cached instance, and its lock is not recursive.
+		let keyRaw = keySchema.state.withLock { $0.raw }
+		let valueRaw = valueSchema.state.withLock { $0.raw }
+		let raw = withUnsafePointer(to: keyRaw) { keyPtr in
+			withUnsafePointer(to: valueRaw) { valuePtr in
+				Bridge_SI_createKeyValue(keyPtr, valuePtr, numericCast(encoding.rawValue))
+			}
+		}
+		self.state = Mutex(Box(raw))
+	}
 }
@@ -0,0 +1,75 @@
+import Foundation
+import Pulsar
+
+/// Compares the JSON schema coder with Foundation's `JSONEncoder` and `JSONDecoder`.
+///
+/// Run in release mode: `swift run -c release PulsarBenchmarks`
+@main
+struct JSONBenchmark {
+	struct LineItem: Codable {
+		let sku: String
+		let quantity: Int
+		let price: Double
+	}
+
+	struct Order: PulsarSchema, JSONProtocol {
+		let id: String
+		let customer: String
+		let express: Bool
+		let note: String?
+		let total: Double
+		let tags: [String]
+		let items: [LineItem]
+	}
+
+	static let iterations = 100_000
+
+	static func main() throws {
+		let order = Order(
+			id: "5f1c0a4e-8c1b-4f64-9d8e-2a1b7c3d9e10",
+			customer: "Jane \"JD\" Doe",
+			express: true,
+			note: nil,
+			total: 1_234.56,
+			tags: ["priority", "gift", "eu"],
+			items: (0 ..< 5).map { LineItem(sku: "SKU-\($0)", quantity: $0 + 1, price: 9.99 * Double($0 + 1)) }
+		)
+		let foundationEncoder = JSONEncoder()
+		let foundationDecoder = JSONDecoder()
+		let data = try order.encode()
+		print("Payload: \(data.count) bytes, \(iterations) iterations")
+
+		let foundationEncode = try measure { _ = try foundationEncoder.encode(order) }
+		let schemaEncode = try measure { _ = try order.encode() }
+		report("encode", foundation: foundationEncode, schema: schemaEncode)
+
+		let foundationDecode = try measure { _ = try foundationDecoder.decode(Order.self, from: data) }
+		let schemaDecode = try measure { _ = try Order.decode(data) }
+		report("decode", foundation: foundationDecode, schema: schemaDecode)
+	}
+
+	static func measure(_ body: () throws -> Void) throws -> Duration {
+		for _ in 0 ..< iterations / 10 {
+			try body()
+		}
+		let clock = ContinuousClock()
+		return try clock.measure {
+			for _ in 0 ..< iterations {
+				try body()
+			}
+		}
+	}
+
+	static func report(_ name: String, foundation: Duration, schema: Duration) {
+		func nanosecondsPerOperation(_ duration: Duration) -> Double {
+			let (seconds, attoseconds) = duration.components
+			return (Double(seconds) * 1e9 + Double(attoseconds) / 1e9) / Double(iterations)
+		}
+		let foundationNanoseconds = nanosecondsPerOperation(foundation)
+		let schemaNanoseconds = nanosecondsPerOperation(schema)
+		print(
+			"\(name): Foundation \(Int(foundationNanoseconds)) ns/op, JSONProtocol \(Int(schemaNanoseconds)) ns/op"
+				+ " (\(String(format: "%.1f", foundationNanoseconds / schemaNanoseconds))x)"
+		)
+	}
+}
@@ -76,6 +76,6 @@ struct Example {
 			try await listener.acknowledge(message)
 			count += 1
 		}
-		try listener.close()
+		try await listener.close()
 	}
 }
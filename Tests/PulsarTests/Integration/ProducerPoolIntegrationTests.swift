@@ -0,0 +1,35 @@
+import Foundation
+import Pulsar
+import Testing
+
+@Suite("ProducerPoolIntegrationTests", .serialized, .disabled(if: ProcessInfo.processInfo.environment["CI"] == "true"))
+struct ProducerPoolIntegrationTests {
+
+	@Test("Pool distributes messages by key")
+	func keyRouting() async throws {
+		let client = Client(
+			serviceURL: URL(string: "pulsar://localhost:6650")!,
+			config: ClientConfiguration(connectionsPerBroker: 4)
+		)
+		let pool: ProducerPool<String> = try client.producerPool(
+			for: "persistent://public/default/producer-pool-test",
+			size: 4,
+			routing: .key
+		)
+		#expect(pool.size == 4)
+
+		for i in 0 ..< 100 {
+			try await pool.send(Message(content: "message \(i)", key: "key-\(i % 10)"))
+		}
+		try await pool.flush()
+
+		let statistics = pool.statistics
+		#expect(statistics.sent == 100)
+		#expect(statistics.succeeded == 100)
+		#expect(statistics.pending == 0)
+		#expect(pool.producerStatistics.count == 4)
+
+		try await pool.shutdown(deadline: ContinuousClock.now + .seconds(10))
+		try await client.close()
+	}
+}
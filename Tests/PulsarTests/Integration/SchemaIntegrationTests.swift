@@ -30,6 +30,28 @@ struct SchemaIntegrationTests {
 		#expect(content.strings == ["one", "two", "three"])
 	}
 
+	struct OrderRecord: PulsarSchema, JSONProtocol, Equatable {
+		let id: String
+		let amount: Double
+		let tags: [String]
+		let note: String?
+	}
+	@Test("JSONSchema")
+	func jsonSchemaTest() throws {
+		let client: Client = Client(serviceURL: URL(string: "pulsar://localhost:6650")!)
+		let producer: Producer<OrderRecord> = try client.producer(for: "persistent://public/default/json-schema-test")
+		let order = OrderRecord(id: "order-1", amount: 9.5, tags: ["new"], note: nil)
+		try producer.send(Message<OrderRecord>(content: order))
+		let consumer: Consumer<OrderRecord> = try client.consumer(
+			for: "persistent://public/default/json-schema-test",
+			subscription: "json-schema-subscription"
+		)
+		let receivedMessage = try consumer.receive(within: .seconds(10))
+		try consumer.close()
+		try client.close()
+		#expect(try receivedMessage.content == order)
+	}
+
 	@Test("StringSchema")
 	func stringSchemaTest() throws {
 		let client: Client = Client(serviceURL: URL(string: "pulsar://localhost:6650")!)
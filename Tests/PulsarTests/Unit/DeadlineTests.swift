@@ -0,0 +1,87 @@
+import Foundation
+import Testing
+
+@testable import Pulsar
+
+@Suite("DeadlineTests")
+struct DeadlineTests {
+
+	@Test("Result callback resumes before the deadline")
+	func resultBeforeDeadline() async throws {
+		try await awaitResult(deadline: ContinuousClock.now + .seconds(10)) { ctx in
+			Unmanaged<DeadlineContinuationBox>.fromOpaque(ctx).takeRetainedValue()
+				.checkContinuation(result: 0, context: "test")
+		}
+	}
+
+	@Test("Deadline resumes with a timeout and drops the late result")
+	func deadlineBeforeResult() async throws {
+		let pending = PendingContext()
+		await #expect(throws: PulsarError.timeout) {
+			try await awaitResult(deadline: ContinuousClock.now + .milliseconds(50)) { ctx in
+				pending.ctx = ctx
+			}
+		}
+		// The late callback must not resume the continuation a second time.
+		let box = Unmanaged<DeadlineContinuationBox>.fromOpaque(try #require(pending.ctx)).takeRetainedValue()
+		box.checkContinuation(result: 0, context: "test")
+	}
+
+	@Test("Retained object outlives the deadline until the result arrives")
+	func retainedUntilResult() async throws {
+		let pending = PendingContext()
+		weak var weakRetained: Retained?
+		do {
+			let retained = Retained()
+			weakRetained = retained
+			await #expect(throws: PulsarError.timeout) {
+				try await awaitResult(deadline: ContinuousClock.now + .milliseconds(50), retaining: retained) { ctx in
+					pending.ctx = ctx
+				}
+			}
+		}
+		#expect(weakRetained != nil)
+		Unmanaged<DeadlineContinuationBox>.fromOpaque(try #require(pending.ctx)).takeRetainedValue()
+			.checkContinuation(result: 0, context: "test")
+		#expect(weakRetained == nil)
+	}
+
+	@Test("Listener drain waits for acknowledgements in flight")
+	func listenerDrain() async throws {
+		let drain = ListenerDrain()
+		try await drain.wait(deadline: ContinuousClock.now + .seconds(10))
+
+		drain.begin()
+		drain.begin()
+		let waiter = Task { try await drain.wait(deadline: ContinuousClock.now + .seconds(10)) }
+		drain.end()
+		drain.end()
+		try await waiter.value
+
+		drain.begin()
+		await #expect(throws: PulsarError.timeout) {
+			try await drain.wait(deadline: ContinuousClock.now + .milliseconds(50))
+		}
+	}
+
+	@Test("Listener shutdown does not wait for buffered messages")
+	func listenerShutdownAfterEarlyBreak() async throws {
+		let listener = Listener<String>()
+		for i in 0 ..< 5 {
+			listener.receive(message: try Message(content: "message \(i)"), consumerPtr: nil)
+		}
+		for try await _ in listener {
+			break
+		}
+
+		let start = ContinuousClock.now
+		try await listener.shutdown(deadline: start + .seconds(10))
+		#expect(ContinuousClock.now - start < .seconds(1))
+	}
+
+	final class PendingContext: @unchecked Sendable {
+		var ctx: UnsafeMutableRawPointer?
+	}
+
+	final class Retained: Sendable {}
+}
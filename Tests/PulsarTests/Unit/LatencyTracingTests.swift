@@ -0,0 +1,39 @@
+import Foundation
+import Testing
+
+@testable import Pulsar
+
+@Suite("LatencyTracingTests")
+struct LatencyTracingTests {
+
+	@Test("Bound trace context is attached to new messages")
+	func traceContextPropagation() throws {
+		let context = TraceContext(
+			traceparent: "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01",
+			tracestate: "vendor=value"
+		)
+		let message = try TraceContext.$current.withValue(context) {
+			try Message<String>(content: "payload")
+		}
+		#expect(message.traceContext == context)
+		#expect(try Message<String>(content: "payload").traceContext == nil)
+	}
+
+	@Test("Tracing is disabled without a positive sample rate")
+	func tracingDisabled() {
+		#expect(LatencyTracer(configuration: nil, topic: "topic", subscription: "sub") == nil)
+		#expect(
+			LatencyTracer(configuration: LatencyTracingConfiguration(sampleRate: 0), topic: "topic", subscription: "sub")
+				== nil
+		)
+	}
+
+	@Test("Tracer samples one in N messages")
+	func sampling() throws {
+		let tracer = try #require(
+			LatencyTracer(configuration: LatencyTracingConfiguration(sampleRate: 0.25), topic: "topic", subscription: "sub")
+		)
+		let sampled = (0 ..< 100).compactMap { _ in tracer.sample() }
+		#expect(sampled.count == 25)
+	}
+}
@@ -0,0 +1,55 @@
+import Foundation
+import Testing
+
+@testable import Pulsar
+
+@Suite("MessageMetadataTests")
+struct MessageMetadataTests {
+
+	@Test("Metadata set on the builder is readable")
+	func builderMetadata() throws {
+		let message = try Message<String>(
+			content: "payload",
+			key: "user-42",
+			orderingKey: "order-1",
+			properties: ["region": "eu", "tenant": "acme"],
+			eventTimestamp: 1_700_000_000_000
+		)
+
+		#expect(message.key == "user-42")
+		#expect(message.orderingKey == "order-1")
+		#expect(message.properties == ["region": "eu", "tenant": "acme"])
+		#expect(message.property("region") == "eu")
+		#expect(message.property("missing") == nil)
+		#expect(message.eventTimestamp == 1_700_000_000_000)
+		#expect(message.publishTimestamp == 0)
+		#expect(message.redeliveryCount == 0)
+		#expect(message.topicName == nil)
+	}
+
+	@Test("Unset metadata is reported as absent")
+	func emptyMetadata() throws {
+		let message = try Message<String>(content: "payload")
+
+		#expect(message.key == nil)
+		#expect(message.orderingKey == nil)
+		#expect(message.properties.isEmpty)
+		#expect(message.eventTimestamp == nil)
+		#expect(message.withUnsafeKey { $0 == nil })
+	}
+
+	@Test("Borrowed views match the bridged values")
+	func borrowedViews() throws {
+		let message = try Message<String>(content: "payload", key: "user-42", properties: ["region": "eu"])
+
+		let keyMatches = message.withUnsafeKey { bytes in
+			bytes.map { $0.elementsEqual("user-42".utf8) } ?? false
+		}
+		let regionMatches = message.withUnsafeProperty("region") { bytes in
+			bytes.map { $0.elementsEqual("eu".utf8) } ?? false
+		}
+		#expect(keyMatches)
+		#expect(regionMatches)
+		#expect(message.withUnsafeProperty("missing") { $0 == nil })
+	}
+}
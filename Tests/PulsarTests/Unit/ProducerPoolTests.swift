@@ -0,0 +1,51 @@
+import Foundation
+import Testing
+
+@testable import Pulsar
+
+@Suite("ProducerPoolTests")
+struct ProducerPoolTests {
+
+	@Test("Round-robin routing cycles through all producers")
+	func roundRobinRouting() throws {
+		let router = ShardRouter(routing: .roundRobin, shardCount: 4)
+		let message = try Message<String>(content: "payload")
+		let indices = (0 ..< 8).map { _ in router.shardIndex(for: message) }
+		#expect(indices == [0, 1, 2, 3, 0, 1, 2, 3])
+	}
+
+	@Test("Key routing keeps each key on one producer")
+	func keyRouting() throws {
+		let router = ShardRouter(routing: .key, shardCount: 4)
+		for i in 0 ..< 20 {
+			let message = try Message<String>(content: "payload", key: "key-\(i)")
+			let index = router.shardIndex(for: message)
+			#expect((0 ..< 4).contains(index))
+			#expect(router.shardIndex(for: message) == index)
+		}
+
+		// Messages without a key fall back to round-robin.
+		let unkeyed = try Message<String>(content: "payload")
+		let indices = Set((0 ..< 4).map { _ in router.shardIndex(for: unkeyed) })
+		#expect(indices == [0, 1, 2, 3])
+	}
+
+	@Test("Thread affinity routing is stable for the calling thread")
+	func threadAffinityRouting() throws {
+		let router = ShardRouter(routing: .threadAffinity, shardCount: 4)
+		let message = try Message<String>(content: "payload")
+		let index = router.shardIndex(for: message)
+		#expect((0 ..< 4).contains(index))
+		for _ in 0 ..< 10 {
+			#expect(router.shardIndex(for: message) == index)
+		}
+	}
+
+	@Test("A single producer always gets every message")
+	func singleProducer() throws {
+		let message = try Message<String>(content: "payload", key: "key")
+		for routing in [ProducerPoolRouting.roundRobin, .threadAffinity, .key] {
+			#expect(ShardRouter(routing: routing, shardCount: 1).shardIndex(for: message) == 0)
+		}
+	}
+}
@@ -119,4 +119,194 @@ struct SchemaUnitTests {
 		let schemaInfo = try UInt.getSchemaInfo()
 		#expect(schemaInfo.schemaType == .int64)
 	}
+
+	@Test("KeyValue INLINE schema encoding/decoding")
+	func keyValueInlineSchema() throws {
+		let value = InlineKeyValue<String, Int32>(key: "user-42", value: 7)
+		let data = try value.encode()
+		#expect(data.prefix(4) == Data([0, 0, 0, 7]))
+		#expect(data.count == 4 + 7 + 4 + 4)
+
+		let decoded = try InlineKeyValue<String, Int32>.decode(data)
+		#expect(try decoded.key == "user-42")
+		#expect(try decoded.value == 7)
+
+		let schemaInfo = try InlineKeyValue<String, Int32>.getSchemaInfo()
+		#expect(schemaInfo.schemaType == .keyValue)
+		#expect(schemaInfo.properties["kv.encoding.type"] == "INLINE")
+	}
+
+	@Test("KeyValue decodes key without touching an invalid value")
+	func keyValueLazyDecoding() throws {
+		// Value bytes are not valid UTF-8, so decoding the value must fail while the key still decodes.
+		let data = Data([0, 0, 0, 1, 0x41, 0, 0, 0, 1, 0xFF])
+		let decoded = try InlineKeyValue<String, String>.decode(data)
+		#expect(try decoded.key == "A")
+		#expect(throws: PulsarError.invalidMessage) { try decoded.value }
+	}
+
+	@Test("KeyValue schema with the same schema instance for key and value")
+	func keyValueSameSchemaInstance() throws {
+		let schema = try String.getSchemaInfo()
+		let schemaInfo = SchemaInfo(keySchema: schema, valueSchema: schema, encoding: .inline)
+		#expect(schemaInfo.properties["key.schema.name"] == schemaInfo.properties["value.schema.name"])
+
+		// JSON schema information is cached, so both sides share one instance.
+		let jsonSchemaInfo = try InlineKeyValue<Order, Order>.getSchemaInfo()
+		#expect(jsonSchemaInfo.schemaType == .keyValue)
+		#expect(jsonSchemaInfo.properties["key.schema.name"] == "Order")
+	}
+
+	@Test("KeyValue SEPARATED schema stores the key as message key")
+	func keyValueSeparatedSchema() throws {
+		let message = try Message(content: SeparatedKeyValue<String, String>(key: "user-42", value: "payload"))
+		#expect(message.key == "user-42")
+		#expect(try message.decodeKey() == "user-42")
+
+		let content = try message.content
+		#expect(try content.key == "user-42")
+		#expect(try content.value == "payload")
+
+		let schemaInfo = try SeparatedKeyValue<String, String>.getSchemaInfo()
+		#expect(schemaInfo.properties["kv.encoding.type"] == "SEPARATED")
+	}
+
+	struct Address: Codable, Equatable {
+		let city: String
+		let zip: Int32
+	}
+
+	struct Order: PulsarSchema, JSONProtocol, Equatable {
+		let id: String
+		let amount: Double
+		let quantity: Int
+		let express: Bool
+		let note: String?
+		let tags: [String]
+		let attributes: [String: Int]
+		let address: Address
+		let createdAt: Date
+	}
+
+	static let order = Order(
+		id: "order-\"42\"\n",
+		amount: 19.99,
+		quantity: -3,
+		express: true,
+		note: nil,
+		tags: ["new", "ünïcødé 🚀"],
+		attributes: ["priority": 1],
+		address: Address(city: "Zürich", zip: 8000),
+		createdAt: Date(timeIntervalSince1970: 1_700_000_000.123)
+	)
+
+	@Test("JSON schema encoding/decoding")
+	func jsonSchema() throws {
+		let data = try Self.order.encode()
+		#expect(try Order.decode(data) == Self.order)
+
+		// The output is plain JSON that Foundation reads as well.
+		let object = try #require(try JSONSerialization.jsonObject(with: data) as? [String: Any])
+		#expect(object["id"] as? String == Self.order.id)
+		#expect(object["createdAt"] as? Int == 1_700_000_000_123)
+		#expect(object["note"] == nil)
+
+		let schemaInfo = try Order.getSchemaInfo()
+		#expect(schemaInfo.schemaType == .json)
+		#expect(schemaInfo.name == "Order")
+		#expect(try Order.getSchemaInfo() === schemaInfo)
+	}
+
+	@Test("JSON schema decodes messages written by other producers")
+	func jsonSchemaInterop() throws {
+		// Java producers may reorder fields, add unknown ones and escape characters differently.
+		let json = """
+			{ "unknown": {"nested": [1, 2, {"deep": null}]}, "tags" : [], "quantity": 3.0e0,
+			  "id": "\\u00fc\\ud83d\\ude80\\/", "amount": 1E2, "express": false, "note": null,
+			  "attributes": {}, "address": {"zip": 1, "city": ""}, "createdAt": 1700000000123 }
+			"""
+		let decoded = try Order.decode(Data(json.utf8))
+		#expect(decoded.id == "ü🚀/")
+		#expect(decoded.quantity == 3)
+		#expect(decoded.amount == 100)
+		#expect(decoded.note == nil)
+		#expect(decoded.createdAt == Date(timeIntervalSince1970: 1_700_000_000.123))
+	}
+
+	@Test("JSON schema rejects invalid documents")
+	func jsonSchemaInvalid() {
+		for json in ["", "{", "{\"id\": }", "[1,]", "{\"id\": \"a\"} x", "{\"quantity\": 01}", "\"\u{01}\""] {
+			#expect(throws: DecodingError.self) { try Order.decode(Data(json.utf8)) }
+		}
+		#expect(throws: DecodingError.self) {
+			try Order.decode(Data(#"{"id": 1}"#.utf8))
+		}
+	}
+
+	@Test("JSON schema definition follows ReflectData.AllowNull")
+	func jsonSchemaDefinition() throws {
+		// Written by applying `ReflectData.AllowNull` to the equivalent POJO, not generated by the Java client.
+		let expected = """
+			{"type":"record","name":"Order","namespace":"org.example","fields":[\
+			{"name":"id","type":["null","string"],"default":null},\
+			{"name":"amount","type":"double"},\
+			{"name":"quantity","type":"long"},\
+			{"name":"express","type":"boolean"},\
+			{"name":"note","type":["null","string"],"default":null},\
+			{"name":"tags","type":["null",{"type":"array","items":"string","java-class":"java.util.List"}],"default":null},\
+			{"name":"attributes","type":["null",{"type":"map","values":"long"}],"default":null},\
+			{"name":"address","type":["null",{"type":"record","name":"Address","namespace":"org.example.Order",\
+			"fields":[{"name":"city","type":["null","string"],"default":null},{"name":"zip","type":"int"}]}],\
+			"default":null},\
+			{"name":"createdAt","type":["null",{"type":"long","logicalType":"timestamp-millis"}],"default":null}]}
+			"""
+		let schemaInfo = try Order.getSchemaInfo()
+		let definition = try #require(schemaInfo.schema)
+		#expect(try canonicalAvro(definition) == canonicalAvro(expected))
+		#expect(schemaInfo.properties["__alwaysAllowNull"] == "true")
+		#expect(schemaInfo.properties["__jsr310ConversionEnabled"] == "false")
+	}
+
+	struct FoundationTypes: Codable, PulsarSchema, JSONProtocol {
+		let date: Date
+		let decimal: Decimal
+		let data: Data
+		let uuid: UUID
+		let url: URL
+		let count: Int
+	}
+
+	@Test("JSON schema definition makes Foundation value fields nullable")
+	func jsonSchemaDefinitionFoundationTypes() throws {
+		let expected = """
+			{"type":"record","name":"FoundationTypes","fields":[\
+			{"name":"date","type":["null",{"type":"long","logicalType":"timestamp-millis"}],"default":null},\
+			{"name":"decimal","type":["null","double"],"default":null},\
+			{"name":"data","type":["null","bytes"],"default":null},\
+			{"name":"uuid","type":["null","string"],"default":null},\
+			{"name":"url","type":["null","string"],"default":null},\
+			{"name":"count","type":"long"}]}
+			"""
+		let definition = try #require(try FoundationTypes.getSchemaInfo().schema)
+		#expect(try canonicalAvro(definition) == canonicalAvro(expected))
+	}
+
+	/// Drops the annotations that Avro's compatibility checks ignore, and serializes with sorted keys.
+	private func canonicalAvro(_ definition: String) throws -> String {
+		func strip(_ value: Any) -> Any {
+			if let array = value as? [Any] {
+				return array.map(strip)
+			}
+			guard var object = value as? [String: Any] else { return value }
+			for annotation in ["namespace", "java-class", "logicalType"] {
+				object[annotation] = nil
+			}
+			if object.count == 1, let type = object["type"] {
+				return strip(type)
+			}
+			return object.mapValues(strip)
+		}
+		let object = strip(try JSONSerialization.jsonObject(with: Data(definition.utf8)))
+		return String(decoding: try JSONSerialization.data(withJSONObject: object, options: .sortedKeys), as: UTF8.self)
+	}
 }